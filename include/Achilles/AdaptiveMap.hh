@@ -40,6 +40,8 @@ class AdaptiveMap {
         // Serialization
         bool Deserialize(std::istream &in);
         bool Serialize(std::ostream &out) const;
+        void SaveState(std::ostream &out) const;
+        bool LoadState(std::istream &in);
 
         // Bin locations
         double lower_edge(size_t dim, size_t bin) const { return m_hist[dim*(m_bins+1) + bin]; }
@@ -59,7 +61,7 @@ class AdaptiveMap {
         std::vector<double>& Hist() { return m_hist; }
 
         // Generate random numbers
-        double operator()(std::vector<double>&);
+        double operator()(std::vector<double>&) const;
         double GenerateWeight(const std::vector<double>&) const;
 
         // Update histograms
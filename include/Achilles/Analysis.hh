@@ -0,0 +1,112 @@
+#ifndef ANALYSIS_HH
+#define ANALYSIS_HH
+
+#include "Achilles/Factory.hh"
+#include "Achilles/Histogram.hh"
+#include "Achilles/ParticleInfo.hh"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace YAML {
+
+class Node;
+
+}
+
+namespace achilles {
+
+class Event;
+
+// Interface for analyses that run inside the generator, such that distributions
+// can be obtained without writing the events to disk. Analyses are registered with
+// the AnalysisFactory, either in Achilles itself or in a shared library that is loaded
+// at runtime. Events are passed from the final state interaction workers, but the
+// AnalysisHandler serializes the calls to Process, such that analyses do not need to be
+// thread-safe.
+class Analysis {
+    public:
+        Analysis() = default;
+        Analysis(const Analysis&) = delete;
+        Analysis(Analysis&&) = default;
+        Analysis& operator=(const Analysis&) = delete;
+        Analysis& operator=(Analysis&&) = default;
+        virtual ~Analysis() = default;
+
+        // Called for each finalized event
+        virtual void Process(const Event&) = 0;
+        // Called once at the end of the run with the total cross section (in nb) and the
+        // sum of the weights of all events passed to Process
+        virtual void Finalize(double, double) {}
+        // Save the results with the given prefix for the output files
+        virtual void Save(const std::string&) const = 0;
+
+        static std::string Name() { return "Analyses"; }
+};
+
+template<typename Derived>
+using RegistrableAnalysis = Registrable<Analysis, Derived, const YAML::Node&>;
+using AnalysisFactory = Factory<Analysis, const YAML::Node&>;
+
+// Energy distributions of the final state particles with the given PIDs
+class FinalStateEnergy : public Analysis, RegistrableAnalysis<FinalStateEnergy> {
+    public:
+        FinalStateEnergy(const YAML::Node&);
+        void Process(const Event&) override;
+        void Finalize(double, double) override;
+        void Save(const std::string&) const override;
+
+        // Required factory methods
+        static std::unique_ptr<Analysis> Construct(const YAML::Node&);
+        static std::string Name() { return "FinalStateEnergy"; }
+
+    private:
+        std::vector<PID> m_pids;
+        std::vector<Histogram> m_hists;
+};
+
+// Loads the analysis libraries and runs the analyses requested in the run card:
+//
+//   Analysis:
+//     Output: results/
+//     Libraries: [libMyAnalysis.so]
+//     Analyses:
+//       - Name: FinalStateEnergy
+//         PIDs: [11]
+//
+// Libraries are searched for as given, and then in the build and install library directories
+class AnalysisHandler {
+    public:
+        AnalysisHandler(const YAML::Node&);
+        AnalysisHandler(const AnalysisHandler&) = delete;
+        AnalysisHandler& operator=(const AnalysisHandler&) = delete;
+        // Destroys the analyses before unloading the libraries they were defined in
+        ~AnalysisHandler();
+
+        void Process(const Event&);
+        void Process(const std::vector<Event>&);
+        void Finalize(double);
+        void Save() const;
+
+        size_t NAnalyses() const { return m_analyses.size(); }
+        const Analysis& GetAnalysis(size_t i) const { return *m_analyses.at(i); }
+        double SumWeights() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_sum_weights;
+        }
+
+    private:
+        void LoadLibrary(const std::string&);
+
+        std::string m_output{};
+        std::vector<void*> m_handles{};
+        std::vector<std::unique_ptr<Analysis>> m_analyses{};
+        mutable std::mutex m_mutex{};
+        double m_sum_weights{};
+};
+
+}
+
+#endif
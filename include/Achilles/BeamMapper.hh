@@ -2,6 +2,9 @@
 #define BEAM_MAPPER_HH
 
 #include "Achilles/Mapper.hh"
+#include "Achilles/ParticleInfo.hh"
+
+#include <map>
 
 namespace achilles {
 
@@ -10,7 +13,9 @@ class Beam;
 
 class BeamMapper : public Mapper<FourVector> {
     public:
-        BeamMapper(size_t idx, std::shared_ptr<Beam> beam) : m_idx{std::move(idx)}, m_beam{std::move(beam)} {}
+        // The mapper generates the given species, or the first species of the beam if none is given
+        BeamMapper(size_t idx, std::shared_ptr<Beam> beam, PID pid=PID::undefined())
+            : m_idx{std::move(idx)}, m_beam{std::move(beam)}, m_pid{pid} {}
 
         void GeneratePoint(std::vector<FourVector>&, const std::vector<double>&) override;
         double GenerateWeight(const std::vector<FourVector>&, std::vector<double>&) override;
@@ -23,8 +28,40 @@ class BeamMapper : public Mapper<FourVector> {
         }
 
     private:
+        PID BeamID() const;
+
         size_t m_idx;
         std::shared_ptr<Beam> m_beam;
+        PID m_pid;
+};
+
+// Species of the beam for the current phase space point. The point only contains the momenta,
+// so the species and the variable that selected it are shared by all channels and the event
+// generation through this state
+struct BeamSelection {
+    PID pid{};
+    double ran{};
+};
+
+// Mapper for beams with several species. The first variable selects the species with the
+// probability given by the beam, and the remaining variables are mapped by the phase space of
+// that species. The selection variable is mapped onto itself, so the density is the density of
+// the phase space of the selected species
+class BeamSpeciesMapper : public Mapper<FourVector> {
+    public:
+        using SpeciesMappers = std::map<PID, std::unique_ptr<Mapper<FourVector>>>;
+
+        BeamSpeciesMapper(std::shared_ptr<Beam>, std::shared_ptr<BeamSelection>, SpeciesMappers);
+
+        void GeneratePoint(std::vector<FourVector>&, const std::vector<double>&) override;
+        double GenerateWeight(const std::vector<FourVector>&, std::vector<double>&) override;
+        size_t NDims() const override { return 1 + m_mappers.begin() -> second -> NDims(); }
+        YAML::Node ToYAML() const override;
+
+    private:
+        std::shared_ptr<Beam> m_beam;
+        std::shared_ptr<BeamSelection> m_selection;
+        SpeciesMappers m_mappers;
 };
 
 }
@@ -30,6 +30,10 @@ class FluxType {
         virtual double GenerateWeight(const FourVector&, std::vector<double>&, double) const = 0;
         virtual std::string Type() const = 0;
         virtual double EvaluateFlux(const FourVector&) const = 0;
+        // Integrated flux, which sets the relative rate of each species in a mixed beam
+        virtual double FluxIntegral() const { return 1; }
+        // Units of the flux, such that the species of a mixed beam can be compared
+        virtual std::string Units() const { return ""; }
 };
 
 class Monochromatic : public FluxType {
@@ -50,15 +54,10 @@ class Monochromatic : public FluxType {
 };
 
 
-// TODO: Figure out how to handle spectrums
-// How to handle this correctly?
-// 1. Generate the energy according to some distribution
-// 2. A. Multiply maximum energy by a fraction to get neutrino energy
-//    B. Calculate the probability for this energy
-// The first requires being able to appropriately sample from the distribution
-// (i.e. having a form for the inverse of the CDF). The second would take advantage
-// of the importance sampling of Vegas. Furthermore, the second would make it easier to
-// combine beams of different initial state particles in a straightforward manner
+// Beam energies are generated either according to the flux itself, using the inverse of the
+// CDF of the interpolated flux above the threshold of each call, or uniformly such that the
+// flux enters through the weight. The first removes the flux from the weight variance, while the
+// second leaves the importance sampling to Vegas
 class Spectrum : public FluxType {
     public:
         enum class Type {
@@ -80,23 +79,40 @@ class Spectrum : public FluxType {
         double MinEnergy() const { return m_min_energy; }
         double MaxEnergy() const { return m_max_energy; }
         double EvaluateFlux(const FourVector&) const override;
+        double FluxIntegral() const override { return m_flux_total; }
+        std::string Units() const override;
+        bool SampleFlux() const { return m_sample_flux; }
+
+        // Integral of the interpolated flux from the minimum energy and its inverse,
+        // with the energy given in the units of the flux file
+        double FluxCDF(double) const;
+        double InverseFluxCDF(double) const;
 
     private:
         void AchillesHeader(std::ifstream&);
         void MiniBooNEHeader(std::ifstream&);
         void T2KHeader(std::ifstream&);
+        void SetupSampling(const std::vector<double>&, const std::vector<double>&);
+        double ThresholdEnergy(double) const;
 
         enum class flux_units {
             v_nb_POT_MeV,
             v_cm2_POT_MeV,
             v_cm2_POT_50MeV,
             cm2_50MeV,
+            unknown,
         };
         std::function<double(double)> m_flux{};
         double m_min_energy{}, m_max_energy{};
         double m_delta_energy{}, m_energy_units{1};
         double m_flux_integral{};
-        flux_units m_units;
+        // Integral of the flux over the energy, independent of the bin widths
+        double m_flux_total{};
+        // Energies are sampled from the inverse CDF of the linearly interpolated flux unless
+        // uniform sampling is requested with "Sampling: Uniform"
+        bool m_sample_flux{true};
+        std::vector<double> m_knots{}, m_heights{}, m_cdf{};
+        flux_units m_units{flux_units::unknown};
         FluxFormat m_format;
 };
 
@@ -126,6 +142,12 @@ class Beam {
             return m_beams.at(pid) -> EvaluateFlux(p);
         }
 
+        // Beams with several species are generated as a single mixture, where each species is
+        // chosen with a probability given by its integrated flux. The fluxes of all species
+        // therefore have to be of the same type and given in the same units
+        double Fraction(const PID pid) const { return m_fractions.at(pid); }
+        MOCK PID SelectBeam(double) const;
+
         // Accessors
         std::shared_ptr<FluxType> operator[](const PID pid) { return m_beams[pid]; }
         std::shared_ptr<FluxType> at(const PID pid) const { return m_beams.at(pid); }
@@ -137,6 +159,7 @@ class Beam {
         int n_vars;
         std::set<PID> m_pids;
         BeamMap m_beams;
+        std::map<PID, double> m_fractions;
 };
 
 }
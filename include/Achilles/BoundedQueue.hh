@@ -0,0 +1,114 @@
+#ifndef BOUNDED_QUEUE_HH
+#define BOUNDED_QUEUE_HH
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace achilles {
+
+// Wait strategy for threads polling a queue: spin briefly before sleeping, such
+// that idle threads do not occupy a core
+inline void QueueBackoff(size_t &idle) {
+    static constexpr size_t max_spins = 64;
+    static constexpr auto sleep_time = std::chrono::microseconds(50);
+    if(idle++ < max_spins) std::this_thread::yield();
+    else std::this_thread::sleep_for(sleep_time);
+}
+
+// Bounded multi-producer / multi-consumer lock-free queue based on the design by
+// D. Vyukov. Each cell carries a sequence number that tells producers and consumers
+// whether the cell is free to be written or ready to be read. The capacity is
+// rounded up to a power of two.
+template<typename T>
+class BoundedQueue {
+    public:
+        explicit BoundedQueue(size_t capacity) {
+            if(capacity < 2) capacity = 2;
+            size_t size = 1;
+            while(size < capacity) size <<= 1;
+            m_mask = size - 1;
+            m_cells = std::make_unique<Cell[]>(size);
+            for(size_t i = 0; i < size; ++i)
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        BoundedQueue(const BoundedQueue&) = delete;
+        BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+        size_t Capacity() const { return m_mask + 1; }
+        // Approximate number of elements, only exact if no other thread is active
+        size_t Size() const {
+            const auto tail = m_tail.load(std::memory_order_relaxed);
+            const auto head = m_head.load(std::memory_order_relaxed);
+            return tail > head ? tail - head : 0;
+        }
+        bool Empty() const { return Size() == 0; }
+
+        // Non-blocking operations, return false if the queue is full (empty)
+        bool TryPush(T &&value) {
+            Cell *cell;
+            auto pos = m_tail.load(std::memory_order_relaxed);
+            for(;;) {
+                cell = &m_cells[pos & m_mask];
+                const auto seq = cell -> sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                if(diff == 0) {
+                    if(m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if(diff < 0) {
+                    return false;
+                } else {
+                    pos = m_tail.load(std::memory_order_relaxed);
+                }
+            }
+            cell -> data = std::move(value);
+            cell -> sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool TryPop(T &value) {
+            Cell *cell;
+            auto pos = m_head.load(std::memory_order_relaxed);
+            for(;;) {
+                cell = &m_cells[pos & m_mask];
+                const auto seq = cell -> sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+                if(diff == 0) {
+                    if(m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if(diff < 0) {
+                    return false;
+                } else {
+                    pos = m_head.load(std::memory_order_relaxed);
+                }
+            }
+            value = std::move(cell -> data);
+            cell -> sequence.store(pos + m_mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Blocking push, waits until space is available. This provides the
+        // back-pressure on the producer if the consumers fall behind
+        void Push(T &&value) {
+            size_t idle = 0;
+            while(!TryPush(std::move(value))) QueueBackoff(idle);
+        }
+
+    private:
+        // Align cells and indices to separate cache lines to avoid false sharing
+        static constexpr size_t cache_line = 64;
+        struct alignas(cache_line) Cell {
+            std::atomic<size_t> sequence{};
+            T data{};
+        };
+
+        std::unique_ptr<Cell[]> m_cells;
+        size_t m_mask{};
+        alignas(cache_line) std::atomic<size_t> m_head{0};
+        alignas(cache_line) std::atomic<size_t> m_tail{0};
+};
+
+}
+
+#endif
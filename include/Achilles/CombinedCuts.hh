@@ -3,6 +3,7 @@
 
 #include "Achilles/OneParticleCuts.hh"
 #include "Achilles/TwoParticleCuts.hh"
+#include "Achilles/ParticleView.hh"
 
 namespace achilles {
 
@@ -13,9 +14,9 @@ class CombinedOneParticleCut {
     public:
         bool Contains(PID pid) const { return m_pids.find(pid) != m_pids.end(); }
         bool MakeCut(const FourVector &mom) const {
-            bool result = true;
-            for(const auto &cut : m_cuts) result &= cut -> MakeCut(mom); 
-            return result;
+            for(const auto &cut : m_cuts)
+                if(!cut -> MakeCut(mom)) return false;
+            return true;
         }
 
         friend YAML::convert<CutCollection>;
@@ -32,11 +33,9 @@ class CombinedTwoParticleCut {
                 && (m_pids.find(pid2) != m_pids.end());
         }
         bool MakeCut(const FourVector &mom1, const FourVector &mom2) const {
-            bool result = true;
-            for(const auto &cut : m_cuts) {
-                result &= cut -> MakeCut(mom1, mom2);
-            }
-            return result;
+            for(const auto &cut : m_cuts)
+                if(!cut -> MakeCut(mom1, mom2)) return false;
+            return true;
         }
 
         friend YAML::convert<CutCollection>;
@@ -48,16 +47,28 @@ class CombinedTwoParticleCut {
 
 class CutCollection {
     public:
-        bool EvaluateCuts(const std::vector<Particle>&);
+        bool EvaluateCuts(const ParticleView&);
+        bool EvaluateCuts(const std::vector<Particle> &parts) { return EvaluateCuts(ParticleView(parts)); }
         double CutEfficiency() const;
         bool AddCut(const std::set<PID>&, std::unique_ptr<OneParticleCut>);
         bool AddCut(const std::set<PID>&, std::unique_ptr<TwoParticleCut>);
 
         friend YAML::convert<CutCollection>;
     private:
+        // Build the lookup tables from the PIDs to the cuts acting on them
+        void Compile();
+        size_t Slot(PID) const;
+
         size_t npass{}, ntot{};
         std::vector<CombinedOneParticleCut> one_part_cuts;
         std::vector<CombinedTwoParticleCut> two_part_cuts;
+
+        // Compiled cut plan: the PIDs with any cut, the one particle cuts for each PID,
+        // and the two particle cuts for each pair of PIDs (dense, indexed by slot pairs)
+        std::vector<PID> m_pids;
+        std::vector<std::vector<size_t>> m_one_plan, m_two_plan;
+        // Final state particles with cuts, as (index, slot), reused between events
+        std::vector<std::pair<size_t, size_t>> m_selected;
 };
 
 }
@@ -0,0 +1,100 @@
+#ifndef CURRENT_TENSOR_HH
+#define CURRENT_TENSOR_HH
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+namespace achilles {
+
+// Table mapping the PIDs of the exchanged bosons to dense slots. The table is fixed
+// when the process is set up, such that currents can be stored without a map
+class BosonSlots {
+    public:
+        static constexpr size_t max_bosons = 4;
+        static constexpr size_t npos = max_bosons;
+
+        // Returns the slot of the boson, adding it if it is not in the table yet
+        size_t Add(int);
+        size_t Slot(int pid) const noexcept {
+            for(size_t i = 0; i < m_size; ++i)
+                if(m_pids[i] == pid) return i;
+            return npos;
+        }
+        int PID(size_t slot) const noexcept { return m_pids[slot]; }
+        size_t size() const noexcept { return m_size; }
+        bool empty() const noexcept { return m_size == 0; }
+        void clear() noexcept { m_size = 0; }
+
+    private:
+        std::array<int, max_bosons> m_pids{};
+        size_t m_size{};
+};
+
+// Currents for the bosons of a BosonSlots table, stored contiguously as (slot, spin, mu).
+// The bounds are fixed at compile time, so the currents can live on the stack
+class CurrentTensor {
+    public:
+        using Complex = std::complex<double>;
+        using Current = std::vector<std::vector<Complex>>;
+        static constexpr size_t max_spins = 4;
+        static constexpr size_t nlorentz = 4;
+
+        CurrentTensor() = default;
+        explicit CurrentTensor(size_t nspins) { Reset(nspins); }
+
+        // Clear all currents and set the number of spin states
+        void Reset(size_t);
+        // Copy a current in the spin-major map representation into the given slot
+        void Set(size_t, const Current&);
+        // Copy the currents for all bosons in the table, bosons not in the map are left empty
+        void Pack(const BosonSlots&, const std::map<int, Current>&, size_t);
+
+        Complex& operator()(size_t slot, size_t spin, size_t mu) {
+            m_active |= 1U << slot;
+            return m_data[Index(slot, spin, mu)];
+        }
+        const Complex& operator()(size_t slot, size_t spin, size_t mu) const {
+            return m_data[Index(slot, spin, mu)];
+        }
+        const Complex* Data(size_t slot, size_t spin) const { return &m_data[Index(slot, spin, 0)]; }
+
+        size_t NSpins() const noexcept { return m_nspins; }
+        bool Active(size_t slot) const noexcept { return (m_active >> slot) & 1U; }
+        unsigned ActiveSlots() const noexcept { return m_active; }
+
+    private:
+        static constexpr size_t Index(size_t slot, size_t spin, size_t mu) {
+            return (slot*max_spins + spin)*nlorentz + mu;
+        }
+
+        std::array<Complex, BosonSlots::max_bosons*max_spins*nlorentz> m_data{};
+        size_t m_nspins{};
+        unsigned m_active{};
+};
+
+// Sum over all spin states of |J_l^mu J_h,mu|^2, where the contraction includes all bosons
+// present in both currents
+inline double ContractSquared(const CurrentTensor &lepton, const CurrentTensor &hadron) {
+    const unsigned active = lepton.ActiveSlots() & hadron.ActiveSlots();
+    double result = 0;
+    for(size_t i = 0; i < lepton.NSpins(); ++i) {
+        for(size_t j = 0; j < hadron.NSpins(); ++j) {
+            std::complex<double> amp{};
+            for(size_t slot = 0; slot < BosonSlots::max_bosons; ++slot) {
+                if(!((active >> slot) & 1U)) continue;
+                const auto *l = lepton.Data(slot, i);
+                const auto *h = hadron.Data(slot, j);
+                amp += l[0]*h[0] - l[1]*h[1] - l[2]*h[2] - l[3]*h[3];
+            }
+            result += std::norm(amp);
+        }
+    }
+    return result;
+}
+
+}
+
+#endif
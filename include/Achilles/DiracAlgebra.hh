@@ -0,0 +1,68 @@
+#ifndef DIRAC_ALGEBRA_HH
+#define DIRAC_ALGEBRA_HH
+
+#include "Achilles/Spinor.hh"
+
+#include <array>
+#include <complex>
+
+namespace achilles {
+
+class FourVector;
+
+// Constant Dirac structures, which are built once on first use instead of for every current.
+// The split versions are used by the vectorized kernels
+struct DiracMatrices {
+    using Vertex = std::array<SpinMatrix, 4>;
+    using SplitVertex = std::array<SplitSpinMatrix, 4>;
+
+    Vertex gamma{};                         // gamma^mu
+    Vertex gamma_gamma5{};                  // gamma^mu gamma^5
+    std::array<Vertex, 4> sigma{};          // sigma^{mu nu}
+    SpinMatrix pl{}, pr{};
+
+    SplitVertex split_gamma{}, split_gamma_gamma5{};
+    std::array<SplitVertex, 4> split_sigma{};
+
+    static SplitVertex Split(const Vertex&);
+
+    static const DiracMatrices& Instance();
+
+    private:
+        DiracMatrices();
+};
+
+// Helicity amplitudes ubar(h1) Gamma^mu u(h2) for all helicity combinations, stored
+// as [2*h1 + h2][mu], where h = 0 is negative helicity and h = 1 is positive helicity
+using HelicityCurrent = std::array<std::array<std::complex<double>, 4>, 4>;
+using HelicitySpinors = std::array<Spinor, 2>;
+
+// Sandwich a vertex between barred and unbarred spinors for all helicity combinations in one pass
+HelicityCurrent Sandwich(const HelicitySpinors&, const DiracMatrices::SplitVertex&, const HelicitySpinors&);
+inline HelicityCurrent Sandwich(const HelicitySpinors &ubar, const DiracMatrices::Vertex &vertex,
+                                const HelicitySpinors &u) {
+    return Sandwich(ubar, DiracMatrices::Split(vertex), u);
+}
+
+// Spinors of both helicities, ordered as negative then positive helicity
+HelicitySpinors UBarSpinors(const FourVector&);
+HelicitySpinors USpinors(const FourVector&);
+
+// Form factor independent bilinears of the vertex
+//   F1 gamma^mu + i F2 sigma^{mu nu} q_nu / (2 M) + FA gamma^mu gamma^5
+// such that the current for each set of form factors only requires a linear combination
+class NucleonBilinears {
+    public:
+        NucleonBilinears(const HelicitySpinors&, const HelicitySpinors&, const FourVector&);
+
+        // Current for the given form factors (F1, F2, FA) and nucleon mass
+        HelicityCurrent operator()(std::complex<double>, std::complex<double>,
+                                   std::complex<double>, double) const;
+
+    private:
+        HelicityCurrent m_vector{}, m_tensor{}, m_axial{};
+};
+
+}
+
+#endif
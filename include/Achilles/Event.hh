@@ -9,6 +9,7 @@
 #include "Achilles/Achilles.hh"
 #include "Achilles/HardScatteringEnum.hh"
 #include "Achilles/NuclearRemnant.hh"
+#include "Achilles/ParticleView.hh"
 #include "Achilles/ProcessInfo.hh"
 
 namespace achilles {
@@ -46,6 +47,10 @@ class Event {
         void SetHardScatteringType(HardScatteringType type) { m_type = type; }
         MOCK void InitializeLeptons(const Process_Info&);
         MOCK void InitializeHadrons(const Process_Info&);
+        /// Sample the nucleon configuration if it has not been generated yet. This is deferred
+        /// until a stage needs the spectator nucleons (cascade, output). The nucleus is only
+        /// used to sample the configuration, the event keeps its own copy of the hadrons
+        MOCK void GenerateConfig();
         void Finalize();
 
         MOCK const NuclearRemnant &Remnant() const { return m_remnant; }
@@ -68,7 +73,9 @@ class Event {
         const double& Flux() const { return flux; }
         double& Flux() { return flux; }
 
-        MOCK vParticles Particles() const;
+        /// View of the hadrons followed by the leptons. The particles are not copied, so the
+        /// view is invalidated by any change to the hadrons or leptons of the event
+        MOCK ParticleView Particles() const;
         const vParticles& Hadrons() const;
         MOCK vParticles& Hadrons();
         const vParticles& Leptons() const { return m_leptons; }
@@ -99,9 +106,14 @@ class Event {
         vMomentum m_mom{};
         std::vector<double> m_me;
         double m_vWgt{}, m_meWgt{}, m_wgt{-1};
+        vParticles m_hadrons{};
         vParticles m_leptons{};
         vParticles m_history{};
         double flux;
+        // Lazy configuration: the struck nucleon is selected as the m_nucleon-th slot
+        // (protons first) and placed in the configuration once it is generated
+        size_t m_nucleon{};
+        bool m_config{false}, m_deferred{false};
 };
 
 }
@@ -1,7 +1,10 @@
 #ifndef EVENTGEN_HH
 #define EVENTGEN_HH
 
+#include "Achilles/Analysis.hh"
 #include "Achilles/CombinedCuts.hh"
+#include "Achilles/EventPipeline.hh"
+#include "Achilles/EventWriter.hh"
 #include "Achilles/Histogram.hh"
 #include "Achilles/ParticleInfo.hh"
 #include "Achilles/QuasielasticTestMapper.hh"
@@ -9,6 +12,7 @@
 #include "Achilles/MultiChannel.hh"
 #include "Achilles/Unweighter.hh"
 
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -26,7 +30,7 @@ class Beam;
 class Nucleus;
 class Cascade;
 class HardScattering;
-class EventWriter;
+struct BeamSelection;
 
 class SherpaMEs;
 
@@ -43,19 +47,35 @@ class EventGen {
         bool MakeCuts(Event&);
         // bool MakeEventCuts(Event&);
         void Rotate(Event&);
+        // Final state interaction stage for a pipeline worker
+        EventPipeline::Stage BuildFSIStage();
+        void WriteEvent(Event&);
+
+        // Checkpointing of the optimized integrator
+        uint64_t ConfigHash() const;
+        void SaveCheckpoint() const;
+        bool LoadCheckpoint();
 
         std::shared_ptr<Beam> beam;
         std::shared_ptr<Nucleus> nucleus;
         std::shared_ptr<Cascade> cascade;
-        std::shared_ptr<HardScattering> scattering;
+        // Hard process for each beam species, and the species of the current point
+        std::map<PID, std::shared_ptr<HardScattering>> scatterings;
+        std::shared_ptr<BeamSelection> selection;
         CutCollection hard_cuts{};
         // CutCollection event_cuts{};
         MultiChannel integrator;
         Integrand<FourVector> integrand;
         YAML::Node config;
+        std::string checkpoint{"achilles.ckpt"};
+        unsigned int seed{};
+        size_t nthreads{0}, queue_depth{1024};
+        ZeroWeightPolicy zero_weight{ZeroWeightPolicy::write};
 
         std::shared_ptr<EventWriter> writer;
         std::unique_ptr<Unweighter> unweighter;
+        std::unique_ptr<EventPipeline> pipeline;
+        std::unique_ptr<AnalysisHandler> analyses;
 };
 
 }
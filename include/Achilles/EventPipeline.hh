@@ -0,0 +1,91 @@
+#ifndef EVENT_PIPELINE_HH
+#define EVENT_PIPELINE_HH
+
+#include "Achilles/BoundedQueue.hh"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace achilles {
+
+class Event;
+
+// Counters for a single stage of the pipeline. Busy time only includes the time
+// spent processing events, not waiting on the queues
+struct PipelineStageStats {
+    std::string name{};
+    size_t processed{}, max_depth{};
+    double busy{}, blocked{};
+
+    double Throughput(double wall) const { return wall > 0 ? static_cast<double>(processed) / wall : 0; }
+};
+
+// Staged producer / consumer pipeline for event generation. The producer (the
+// integrator thread) pushes events after the hard scattering. A pool of workers
+// runs the final state interactions, and a single writer thread writes the events
+// out. The stages are connected by bounded lock-free queues, such that a producer
+// that runs ahead of the workers is blocked until space becomes available.
+class EventPipeline {
+    public:
+        // One stage per worker, such that each worker can own its own state
+        // (i.e. the nucleus and the cascade)
+        using Stage = std::function<void(Event&)>;
+        using Writer = std::function<void(const Event&)>;
+
+        EventPipeline(std::vector<Stage>, size_t depth, Writer, unsigned int seed);
+        EventPipeline(const EventPipeline&) = delete;
+        EventPipeline& operator=(const EventPipeline&) = delete;
+        ~EventPipeline();
+
+        // Send an event through the final state interaction workers
+        void Push(Event&&);
+        // Send an event directly to the writer (i.e. rejected events)
+        void PushProcessed(Event&&);
+        // Drain all queues and join the threads. Rethrows the first exception
+        // raised on any of the worker threads
+        void Finish();
+
+        size_t NWorkers() const { return m_workers.size(); }
+        std::vector<PipelineStageStats> Stats() const;
+        void Report() const;
+
+    private:
+        using EventPtr = std::unique_ptr<Event>;
+        struct StageCounters {
+            std::atomic<size_t> processed{}, max_depth{};
+            std::atomic<int64_t> busy{}, blocked{};
+        };
+
+        void RunWorker(Stage&, unsigned int);
+        void RunWriter();
+        void PushQueue(BoundedQueue<EventPtr>&, EventPtr, StageCounters&, StageCounters&);
+        void SetError(std::exception_ptr);
+        static void UpdateDepth(StageCounters&, size_t);
+
+        BoundedQueue<EventPtr> m_fsi_queue, m_write_queue;
+        std::vector<Stage> m_stages;
+        Writer m_writer;
+        std::vector<std::thread> m_workers;
+        std::thread m_writer_thread;
+        std::atomic<bool> m_producer_done{false}, m_workers_done{false}, m_failed{false};
+        std::atomic<size_t> m_active_workers{};
+
+        StageCounters m_producer, m_fsi, m_write;
+        std::chrono::steady_clock::time_point m_start;
+        double m_wall{};
+        bool m_finished{false};
+
+        std::mutex m_error_mutex;
+        std::exception_ptr m_error{};
+};
+
+}
+
+#endif
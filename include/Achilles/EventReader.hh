@@ -0,0 +1,63 @@
+#ifndef EVENT_READER_HH
+#define EVENT_READER_HH
+
+#include "Achilles/ParallelGzip.hh"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace achilles {
+
+// Byte offsets of the events in an Achilles event file. The offsets refer to the
+// uncompressed data and include the end of the last event. For block compressed
+// files the frames map the uncompressed offsets to the independent gzip members.
+// The index is stored as a sidecar file next to the event file.
+struct EventIndex {
+    std::vector<uint64_t> offsets{};
+    std::vector<GzipFrame> frames{};
+
+    size_t NEvents() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    static std::string Filename(const std::string &events) { return events + ".idx"; }
+    void Save(const std::string&) const;
+    bool Load(const std::string&);
+};
+
+// Random access reader for files written by the AchillesWriter. The file is memory
+// mapped, and only the events requested are read. For compressed files only the
+// frames containing the event are decompressed. All methods are const and can be
+// called from multiple threads.
+class AchillesReader {
+    public:
+        AchillesReader(const std::string&);
+        AchillesReader(const AchillesReader&) = delete;
+        AchillesReader& operator=(const AchillesReader&) = delete;
+        ~AchillesReader();
+
+        size_t NEvents() const { return m_index.NEvents(); }
+        bool Compressed() const { return m_compressed; }
+
+        // Text of the given event
+        std::string Event(size_t) const;
+        // Zero-copy view of the given event, only available for uncompressed files
+        std::string_view RawEvent(size_t) const;
+        // Range of events [begin, end) of shard i out of n shards, for parallel iteration
+        std::pair<size_t, size_t> Shard(size_t, size_t) const;
+
+    private:
+        void BuildIndex();
+        void CheckEvent(size_t) const;
+        std::string Inflate(uint64_t, uint64_t) const;
+
+        int m_fd{-1};
+        const char *m_data{nullptr};
+        size_t m_size{};
+        bool m_compressed{false};
+        EventIndex m_index{};
+};
+
+}
+
+#endif
@@ -1,22 +1,39 @@
 #ifndef EVENT_WRITER_HH
 #define EVENT_WRITER_HH
 
+#include <atomic>
+#include <cstdint>
+#include <exception>
 #include <ostream>
 #include <fstream>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "Achilles/BoundedQueue.hh"
+
 #if GZIP
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wshadow"
 #include "gzstream/gzstream.h"
 #pragma GCC diagnostic pop
+#include "Achilles/ParallelGzip.hh"
 #endif
 
 namespace achilles {
 
 class Event;
 
+// Treatment of events with zero weight, e.g. events rejected by the cuts or the
+// unweighting. These events carry no information except that they were generated,
+// so they can be written without particles or skipped entirely
+enum class ZeroWeightPolicy {
+    write,
+    compact,
+    skip,
+};
+
 class EventWriter {
     public:
         EventWriter() = default;
@@ -28,40 +45,82 @@ class EventWriter {
 
         virtual void WriteHeader(const std::string&) = 0;
         virtual void Write(const Event&) = 0;
+
+        void SetZeroWeightPolicy(ZeroWeightPolicy policy) { m_zero_weight = policy; }
+        ZeroWeightPolicy GetZeroWeightPolicy() const { return m_zero_weight; }
+
+    protected:
+        // Policy applying to the event, write for all events with non-zero weight
+        ZeroWeightPolicy Policy(const Event&) const;
+
+    private:
+        ZeroWeightPolicy m_zero_weight{ZeroWeightPolicy::write};
 };
 
 class AchillesWriter : public EventWriter {
     public:
-        AchillesWriter(const std::string&, bool=true);
+        // Zipped output is compressed in blocks on the given number of threads
+        AchillesWriter(const std::string&, bool=true, int level=6, size_t threads=1);
+        // Writes to a stream owned by the caller
         AchillesWriter(std::ostream *out) : m_out{out} {}
-        AchillesWriter(const AchillesWriter&) = default;
+        AchillesWriter(const AchillesWriter&) = delete;
         AchillesWriter(AchillesWriter&&) = default;
-        AchillesWriter& operator=(const AchillesWriter&) = default;
+        AchillesWriter& operator=(const AchillesWriter&) = delete;
         AchillesWriter& operator=(AchillesWriter&&) = default;
-        ~AchillesWriter() override {
-            if(toFile) {
-#ifdef GZIP
-                if(zipped) {
-                    dynamic_cast<ogzstream*>(m_out) -> close();
-                } else {
-                    dynamic_cast<std::ofstream*>(m_out) -> close();
-                }
-#else
-                dynamic_cast<std::ofstream*>(m_out) -> close();
-#endif
-                delete m_out;
-            }
-            m_out = nullptr;
-        }
+        // Closes the file and writes the event index next to it
+        ~AchillesWriter() override;
 
         void WriteHeader(const std::string&) override;
         void Write(const Event&) override;
 
+        // Uncompressed byte offsets of the events written so far
+        const std::vector<uint64_t>& Offsets() const { return m_offsets; }
+
     private:
+        void WriteString(const std::string&);
+
         bool toFile{false};
         bool zipped{true};
         size_t nEvents{0};
-        std::ostream *m_out; 
+        // The file stream is owned by the writer, while m_out may also point to an external stream
+        std::unique_ptr<std::ostream> m_file{};
+        std::ostream *m_out{};
+        std::string m_filename{};
+        uint64_t m_bytes{};
+        std::vector<uint64_t> m_offsets{};
+};
+
+// Wraps any EventWriter, such that formatting and compressing the events happens
+// on a background thread. Events are copied into a ring buffer of fixed depth, and
+// the calling thread only waits if the buffer is full. All buffered events are
+// written before the wrapped writer is destroyed.
+class AsyncEventWriter : public EventWriter {
+    public:
+        AsyncEventWriter(std::unique_ptr<EventWriter>, size_t depth=1024);
+        AsyncEventWriter(const AsyncEventWriter&) = delete;
+        AsyncEventWriter(AsyncEventWriter&&) = delete;
+        AsyncEventWriter& operator=(const AsyncEventWriter&) = delete;
+        AsyncEventWriter& operator=(AsyncEventWriter&&) = delete;
+        ~AsyncEventWriter() override;
+
+        void WriteHeader(const std::string&) override;
+        void Write(const Event&) override;
+        // Wait until all buffered events have been written
+        void Flush();
+
+        size_t Depth() const { return m_buffer.Capacity(); }
+        size_t Written() const { return m_written.load(); }
+
+    private:
+        void Run();
+        void CheckError();
+
+        std::unique_ptr<EventWriter> m_writer;
+        BoundedQueue<std::unique_ptr<Event>> m_buffer;
+        std::atomic<size_t> m_pushed{}, m_written{};
+        std::atomic<bool> m_done{false}, m_failed{false};
+        std::exception_ptr m_error{};
+        std::thread m_thread;
 };
 
 }
@@ -6,6 +6,7 @@
 #include <array>
 #include <memory>
 #include <complex>
+#include <vector>
 
 #include "Achilles/Achilles.hh"
 #include "yaml-cpp/node/node.h"
@@ -258,6 +259,44 @@ class LovatoFormFactor : public FormFactorImpl, RegistrableFormFactor<LovatoForm
         std::array<double, 5> c{};
 };
 
+// Tabulates any other form factor on a uniform Q2 grid at startup, such that each evaluation is
+// a single cubic interpolation of all the values set by the form factor. The grid is refined until
+// the deviation from the analytic form factor at the midpoints is below the tolerance. Outside of
+// the grid the analytic form factor is used. Configured per type as:
+//
+//   Tabulated:
+//     vector:
+//       Form Factor: Kelly
+//       Q2 Max: 20
+//     Kelly: *Kelly
+//
+// with the optional parameters Q2 Min (default 0), Tolerance (default 1e-6) and Max Points. The
+// last two can also be given once for all types
+class TabulatedFormFactor : public FormFactorImpl, RegistrableFormFactor<TabulatedFormFactor> {
+    public:
+        TabulatedFormFactor(FFType, const YAML::Node&);
+        void Evaluate(double, FormFactor::Values&) const override;
+
+        // Maximum absolute deviation from the analytic form factor found on the final grid
+        double MaxDeviation() const { return m_max_deviation; }
+        size_t NPoints() const { return m_npoints; }
+
+        // Required factory methods
+        static std::unique_ptr<FormFactorImpl> Construct(FFType, const YAML::Node&);
+        static std::string Name() { return "Tabulated"; }
+
+    private:
+        using Field = double FormFactor::Values::*;
+        void Tabulate(size_t);
+        double Deviation() const;
+
+        std::unique_ptr<FormFactorImpl> m_form_factor;
+        std::vector<Field> m_fields{};
+        std::vector<double> m_table{};
+        double m_q2min{}, m_q2max{}, m_step{}, m_max_deviation{};
+        size_t m_npoints{};
+};
+
 
 }
 
@@ -0,0 +1,91 @@
+#ifndef HDF5_EVENT_WRITER_HH
+#define HDF5_EVENT_WRITER_HH
+
+#include "Achilles/EventWriter.hh"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#include "H5Cpp.h"
+#pragma GCC diagnostic pop
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace achilles {
+
+class Particle;
+
+// Binary columnar event output. Each event quantity is stored in its own chunked
+// and compressed dataset, such that the file can be loaded directly into numpy or
+// pandas (i.e. through h5py) without parsing. The layout is:
+//
+//   /events/weight, /events/flux   (double, one entry per event)
+//   /events/remnant                (int32, PID of the nuclear remnant)
+//   /events/offset                 (uint64, index of the first particle of the event)
+//   /particles/pid, /particles/status  (int32, one entry per particle)
+//   /particles/momentum            (double, [nparticles, 4])
+//
+// The run card and the Achilles version are stored as attributes of the root group.
+class HDF5Writer : public EventWriter {
+    public:
+        static constexpr size_t chunk_default = 4096;
+        static constexpr unsigned int compression_default = 4;
+
+        HDF5Writer(const std::string&, unsigned int compression=compression_default,
+                   size_t chunk=chunk_default);
+        HDF5Writer(const HDF5Writer&) = delete;
+        HDF5Writer(HDF5Writer&&) = delete;
+        HDF5Writer& operator=(const HDF5Writer&) = delete;
+        HDF5Writer& operator=(HDF5Writer&&) = delete;
+        ~HDF5Writer() override;
+
+        void WriteHeader(const std::string&) override;
+        void Write(const Event&) override;
+        // Write all buffered events to the file
+        void Flush();
+
+    private:
+        H5::DataSet CreateDataSet(H5::Group&, const std::string&, const H5::PredType&, hsize_t=1);
+
+        H5::H5File m_file;
+        unsigned int m_compression;
+        hsize_t m_chunk;
+        H5::DataSet m_weight, m_flux, m_remnant, m_offset;
+        H5::DataSet m_pid, m_status, m_momentum;
+
+        // Buffers of the events not written yet
+        std::vector<double> m_weights{}, m_fluxes{}, m_momenta{};
+        std::vector<int32_t> m_remnants{}, m_pids{}, m_statuses{};
+        std::vector<uint64_t> m_offsets{};
+        uint64_t m_nparticles{};
+};
+
+// Reads back files written by the HDF5Writer. The event level columns are loaded on
+// construction, and the particles are read for each event on request.
+class HDF5Reader {
+    public:
+        HDF5Reader(const std::string&);
+
+        size_t NEvents() const { return m_weights.size(); }
+        const std::string& RunCard() const { return m_run_card; }
+        const std::string& Version() const { return m_version; }
+
+        const std::vector<double>& Weights() const { return m_weights; }
+        const std::vector<double>& Fluxes() const { return m_fluxes; }
+        const std::vector<int32_t>& Remnants() const { return m_remnants; }
+        std::vector<Particle> Particles(size_t) const;
+
+    private:
+        H5::H5File m_file;
+        H5::DataSet m_pid, m_status, m_momentum;
+        std::string m_run_card{}, m_version{};
+        std::vector<double> m_weights{}, m_fluxes{};
+        std::vector<int32_t> m_remnants{};
+        std::vector<uint64_t> m_offsets{};
+        uint64_t m_nparticles{};
+};
+
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define HADRONIC_MAPPER_HH
 
 #include <cmath>
+#include <memory>
 
 #include "Achilles/Mapper.hh"
 #include "Achilles/PhaseSpaceFactory.hh"
@@ -9,6 +10,7 @@
 namespace achilles {
 
 class FourVector;
+class SpectralSampler;
 
 class HadronicBeamMapper : public Mapper<FourVector> {
     public:
@@ -37,6 +39,11 @@ class HadronicBeamMapper : public Mapper<FourVector> {
 class QESpectralMapper : public HadronicBeamMapper, RegistrablePS<HadronicBeamMapper, QESpectralMapper, size_t> {
     public:
         QESpectralMapper(size_t idx) : HadronicBeamMapper(idx, Name()) {}
+        // Samples the momentum and removal energy from the spectral function instead of uniformly.
+        // Both are restricted to the kinematically allowed region, and the density is renormalized
+        // accordingly. Outside of the table the uniform sampling is used
+        QESpectralMapper(size_t idx, std::shared_ptr<const SpectralSampler> sampler)
+            : HadronicBeamMapper(idx, Name()), m_sampler{std::move(sampler)} {}
         static std::string Name() { return "QESpectral"; }
         static std::unique_ptr<HadronicBeamMapper> Construct(const size_t &idx) {
             return std::make_unique<QESpectralMapper>(idx);
@@ -45,12 +52,23 @@ class QESpectralMapper : public HadronicBeamMapper, RegistrablePS<HadronicBeamMa
         void GeneratePoint(std::vector<FourVector>&, const std::vector<double>&) override;
         double GenerateWeight(const std::vector<FourVector>&, std::vector<double>&) override;
         size_t NDims() const override { return 4; }
+        YAML::Node ToYAML() const override {
+            auto result = HadronicBeamMapper::ToYAML();
+            result["Sampled"] = m_sampler != nullptr;
+            return result;
+        }
 
     private:
+        // Normalization of the sampled distributions in the allowed region, zero if the
+        // uniform sampling is used
+        double MomentumNorm(double) const;
+        double EnergyNorm(double, double) const;
+
         // static constexpr double dCos = 2;
         static constexpr double dPhi = 2*M_PI;
         // static constexpr double dp = 800;
         // static constexpr double dE = 400;
+        std::shared_ptr<const SpectralSampler> m_sampler{};
 };
 
 class CoherentMapper : public HadronicBeamMapper, RegistrablePS<HadronicBeamMapper, CoherentMapper, size_t> {
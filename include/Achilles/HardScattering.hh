@@ -11,6 +11,8 @@
 #include "yaml-cpp/yaml.h"
 #pragma GCC diagnostic pop
 
+#include "Achilles/CurrentTensor.hh"
+#include "Achilles/DiracAlgebra.hh"
 #include "Achilles/HardScatteringEnum.hh"
 #include "Achilles/Beams.hh"
 #include "Achilles/RunModes.hh"
@@ -33,18 +35,23 @@ using Particles = std::vector<Particle>;
 using Current = std::vector<std::vector<std::complex<double>>>;
 using Currents = std::map<int, Current>;
 using FFDictionary = std::map<std::pair<PID, PID>, std::vector<FormFactorInfo>>;
+using FFInfoMap = std::map<int, std::vector<FormFactorInfo>>;
 
 class LeptonicCurrent {
     public:
         LeptonicCurrent() = default;
         void Initialize(const Process_Info&);
         FFDictionary GetFormFactor();
-        Currents CalcCurrents(const std::vector<FourVector>&, const double&) const;
+        // Fills the current for the exchanged boson into slot 0
+        void CalcCurrents(const std::vector<FourVector>&, const double&, CurrentTensor&) const;
+        int Boson() const { return pid; }
 
     private:
         bool NeutralCurrent(PID, PID) const;
         bool ChargedCurrent(bool, PID, PID) const;
         std::complex<double> coupl_left{}, coupl_right{};
+        // Vertex coupl_left gamma^mu P_L + coupl_right gamma^mu P_R, fixed by the process
+        DiracMatrices::SplitVertex m_vertex{};
         double mass{}, width{};
         int pid{};
         bool anti{};
@@ -72,15 +79,20 @@ class HardScattering {
 
         // Pointer operations
 #ifdef ENABLE_BSM
-        void SetSherpa(SherpaMEs *const _sherpa) { p_sherpa = _sherpa; }
+        void SetSherpa(SherpaMEs *const);
 #endif
         void SetNuclear(std::unique_ptr<NuclearModel> model) { m_nuclear = std::move(model); }
         NuclearModel* Nuclear() { return m_nuclear.get(); }
 
     private:
-        Currents LeptonicCurrents(const std::vector<FourVector>&,
-                                  const double&) const;
+        void LeptonicCurrents(const std::vector<FourVector>&, const double&,
+                              BosonSlots&, CurrentTensor&) const;
+        void SetupFormFactors();
         FFDictionary SMFormFactor;
+        BosonSlots m_bosons{};
+        // Form factor couplings for the proton, neutron and carbon for each boson. Resolved once
+        // when the process is configured, and only read while calculating cross sections
+        std::vector<FFInfoMap> m_ffInfo{};
 
 #ifdef ENABLE_BSM
         SherpaMEs *p_sherpa{nullptr};
@@ -1,8 +1,10 @@
 #ifndef HISTOGRAM_HH
 #define HISTOGRAM_HH
 
+#include <cstdint>
 #include <string>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <vector>
@@ -38,19 +40,32 @@ namespace achilles {
 
 class FourVector;
 
+// Histogram that can be filled from multiple threads without locking. Each thread
+// fills its own shard, and the shards are merged when the histogram is read. Reading,
+// scaling, or saving the histogram must not happen while other threads are filling it.
 class Histogram {
     public:
-        Histogram() = default;
+        Histogram();
         Histogram(const size_t&, const double&, const double&,
                   std::string, std::string path="");
         Histogram(std::vector<double>, std::string, std::string path="");
-        Histogram(const Histogram&) = default;
-        Histogram(Histogram&&) = default;
-        Histogram& operator=(const Histogram&) = default;
-        Histogram& operator=(Histogram&&) = default;
+        Histogram(const Histogram&);
+        Histogram(Histogram&&) noexcept;
+        Histogram& operator=(const Histogram&);
+        Histogram& operator=(Histogram&&) noexcept;
         virtual ~Histogram() = default;
 
         virtual void Fill(const double& x, const double& wgt=1.0);
+        // Fill a batch of values with the corresponding weights
+        virtual void Fill(const std::vector<double>& x, const std::vector<double>& wgt);
+        // Combine the contributions of all threads into the bin values
+        void Merge();
+        size_t Entries() const;
+        // Number of threads that have filled the histogram
+        size_t NShards() const;
+        // Number of histograms the calling thread keeps a shard for, including
+        // destroyed histograms that have not been cleaned up yet
+        static size_t NLocalShards();
         virtual void Scale(const double&);
         virtual void Normalize(const double& norm=1.0);
         virtual double Integral() const;
@@ -70,6 +85,32 @@ class Histogram {
         std::vector<double> errors;
         size_t nentries{};
         size_t FindBin(const double&) const;
+
+    private:
+        struct Shard {
+            Shard(size_t nbins) : binvals(nbins), errors(nbins) {}
+            std::vector<double> binvals, errors;
+            size_t nentries{};
+        };
+
+        // Shards filled by a thread, by histogram id
+        struct LocalShards;
+        static LocalShards& ThreadShards();
+
+        void CheckUniform();
+        Shard& LocalShard();
+        void Accumulate(Shard&, double, double) const;
+        Shard Snapshot() const;
+
+        // Uniform bins are found directly instead of with a binary search
+        bool uniform{false};
+        double inv_width{};
+        // Unique id used by the threads to find their shard of this histogram
+        uint64_t m_id;
+        mutable std::mutex m_mutex;
+        // Shared with the threads filling the histogram, such that they can
+        // detect when the histogram is destroyed
+        std::vector<std::shared_ptr<Shard>> m_shards;
 };
 
 #ifdef HAVE_YODA
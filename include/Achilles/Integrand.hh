@@ -15,6 +15,7 @@ struct Channel {
     double weight{};
     std::vector<double> train_data;
     std::vector<double> rans;
+    size_t hypercube{};
 
     size_t NDims() const { return mapping -> NDims(); }
 };
@@ -53,9 +54,15 @@ class Integrand {
             }
         }
         void AddTrainData(size_t channel, const double val2) {
-            const auto grid = channels[channel].integrator.Grid();
+            auto &integrator = channels[channel].integrator;
+            const auto &grid = integrator.Grid();
             for(size_t j = 0; j < grid.Dims(); ++j) 
                 channels[channel].train_data[j * grid.Bins() + grid.FindBin(j, channels[channel].rans[j])] += val2;
+
+            // Remove the hypercube density to train the stratification on the integrand itself
+            const auto hypercube = channels[channel].hypercube;
+            const double density = integrator.Strata().Density(hypercube);
+            integrator.AddTrainData(hypercube, val2 * density * density);
         }
         void Train() {
             for(auto &channel : channels) {
@@ -67,8 +74,8 @@ class Integrand {
         }
 
         // Interface to MultiChannel integration
-        void GeneratePoint(size_t channel, std::vector<double> &rans, std::vector<T> &point) const {
-            channels[channel].integrator.Grid()(rans);
+        void GeneratePoint(size_t channel, std::vector<double> &rans, std::vector<T> &point) {
+            channels[channel].hypercube = channels[channel].integrator.Sample(rans);
             channels[channel].mapping -> GeneratePoint(point, rans); 
         }
         double GenerateWeight(const std::vector<double> &wgts, const std::vector<T> &point,
@@ -84,6 +91,22 @@ class Integrand {
             return 1.0 / weight;
         }
 
+        // Binary checkpointing of the channel grids. The mappers are not stored,
+        // and must be rebuilt from the run card before loading
+        void SaveState(std::ostream &out) const {
+            io::WriteSize(out, channels.size());
+            for(const auto &channel : channels) channel.integrator.SaveState(out);
+        }
+        bool LoadState(std::istream &in) {
+            uint64_t nchannels{};
+            if(!io::ReadBinary(in, nchannels) || nchannels != channels.size()) return false;
+            for(auto &channel : channels) {
+                if(!channel.integrator.LoadState(in)) return false;
+                if(channel.integrator.Grid().Dims() != channel.NDims()) return false;
+            }
+            return true;
+        }
+
         // YAML interface
         friend YAML::convert<achilles::Integrand<T>>;
 
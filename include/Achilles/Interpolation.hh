@@ -141,6 +141,51 @@ class Interp2D {
         std::vector<Interp1D> derivs2;
 };
 
+/// Class to interpolate data given on a regular grid, using a cubic polynomial in x and a
+/// linear polynomial in y. This is the same interpolant as Interp2D in polynomial mode with
+/// order (3, 1), but the cell is found by index arithmetic and the polynomial coefficients
+/// are computed once when the grid is set up, such that no memory is allocated per call.
+class RegularGridInterp2D {
+    public:
+        /// @name Constructor and Destructor
+        ///@{
+
+        /// Constructor
+        RegularGridInterp2D() = default;
+        RegularGridInterp2D(const std::vector<double>&, const std::vector<double>&,
+                            const std::vector<double>&);
+        RegularGridInterp2D(const RegularGridInterp2D&) = default;
+        RegularGridInterp2D(RegularGridInterp2D&&) = default;
+        RegularGridInterp2D& operator=(const RegularGridInterp2D&) = default;
+        RegularGridInterp2D& operator=(RegularGridInterp2D&&) = default;
+
+        /// Destructor
+        ~RegularGridInterp2D() = default;
+        ///@}
+
+        /// Check if the knots are equally spaced within the given relative tolerance
+        static bool IsRegular(const std::vector<double>&, double=1e-8);
+
+        double Xmin() const { return m_xmin; }
+        double Xmax() const { return m_xmax; }
+        double Ymin() const { return m_ymin; }
+        double Ymax() const { return m_ymax; }
+
+        /// Function to perform the interpolation at the given input point
+        ///@param x: x-value to interpolate the function at
+        ///@param y: y-value to interpolate the fucntion at
+        ///@return double: The interpolated value of the function
+        double operator()(double, double) const;
+
+    private:
+        double m_xmin{}, m_xmax{}, m_ymin{}, m_ymax{};
+        double m_invhx{}, m_invhy{};
+        size_t m_nx{}, m_ny{};
+        // Coefficients of the cubic in x for each x cell and y knot, stored as (cell, knot, power).
+        // The cubic is expanded around the first point of the four point stencil of the cell
+        std::vector<double> m_coeffs;
+};
+
 }
 
 #endif // end of include guard: INTERPOLATION_HH
@@ -4,6 +4,8 @@
 #include "Achilles/Vegas.hh"
 #include "Achilles/Integrand.hh"
 
+#include <cmath>
+
 namespace achilles {
 
 struct MultiChannelSummary {
@@ -12,6 +14,22 @@ struct MultiChannelSummary {
     StatsData sum_results;
 
     StatsData Result() const { return sum_results; }
+    void SaveState(std::ostream &out) const {
+        io::WriteSize(out, results.size());
+        for(const auto &result : results) result.SaveState(out);
+        io::WriteBinary(out, best_weights);
+    }
+    bool LoadState(std::istream &in) {
+        uint64_t nresults{};
+        if(!io::ReadBinary(in, nresults)) return false;
+        results.resize(nresults);
+        sum_results = StatsData();
+        for(auto &result : results) {
+            if(!result.LoadState(in)) return false;
+            sum_results += result;
+        }
+        return io::ReadBinary(in, best_weights);
+    }
 };
 
 struct MultiChannelParams {
@@ -43,11 +61,15 @@ class MultiChannel {
         template<typename T>
         void operator()(Integrand<T>&);
         template<typename T>
-        void Optimize(Integrand<T>&);
+        void Optimize(Integrand<T>&, const std::function<void()>& = {});
 
         // Getting results
         MultiChannelSummary Summary();
 
+        // Binary checkpointing of the channel weights and accumulated results
+        void SaveState(std::ostream&) const;
+        bool LoadState(std::istream&);
+
         // YAML interface
         friend YAML::convert<achilles::MultiChannel>;
 
@@ -63,6 +85,15 @@ class MultiChannel {
                     channel.integrator.Refine();
             }
         }
+        // The channels are sampled at random, so the strata of each channel are sized
+        // from the calls it receives per iteration
+        template<typename T>
+        void StratifyChannels(Integrand<T> &func) {
+            for(size_t i = 0; i < channel_weights.size(); ++i) {
+                const double ncalls = static_cast<double>(params.ncalls) * channel_weights[i];
+                func.GetChannel(i).integrator.SetCalls(static_cast<size_t>(std::lround(ncalls)));
+            }
+        }
         void PrintIteration() const;
         void MaxDifference(const std::vector<double>&);
 
@@ -116,15 +147,21 @@ void achilles::MultiChannel::operator()(Integrand<T> &func) {
 }
 
 template<typename T>
-void achilles::MultiChannel::Optimize(Integrand<T> &func) {
+void achilles::MultiChannel::Optimize(Integrand<T> &func, const std::function<void()> &checkpoint) {
+    // Resume from previously accumulated iterations if there are any
     double rel_err = lim::max();
+    if(summary.results.size() > 1)
+        rel_err = summary.sum_results.Error() / std::abs(summary.sum_results.Mean());
+
     while((rel_err > params.rtol) || summary.results.size() < params.niterations) {
+        StratifyChannels(func);
         (*this)(func);
         StatsData current = summary.sum_results;
         rel_err = current.Error() / std::abs(current.Mean());
 
         PrintIteration();
         if(++params.iteration == params.nrefine) RefineChannels(func);
+        if(checkpoint) checkpoint();
     }
 }
 
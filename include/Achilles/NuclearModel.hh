@@ -15,7 +15,8 @@ namespace achilles {
 
 class PID;
 class PSBuilder;
-class Spinor;
+class HadronicBeamMapper;
+class NucleonBilinears;
 
 enum class NuclearMode {
     None = -1,
@@ -49,6 +50,9 @@ class NuclearModel {
         virtual void AllowedStates(Process_Info&) const = 0;
         virtual size_t NSpins() const = 0;
         virtual bool FillNucleus(Event&, const std::vector<double>&) const = 0;
+        // Additional mappers for the initial hadron with the given index, which sample from the
+        // model itself. Each mapper is used as an extra channel next to the one given by PhaseSpace
+        virtual std::vector<std::shared_ptr<HadronicBeamMapper>> HadronicChannels(size_t) const { return {}; }
 
         static std::string Name() { return "Nuclear Model"; }
 
@@ -96,6 +100,7 @@ class QESpectral : public NuclearModel, RegistrableNuclearModel<QESpectral> {
         void AllowedStates(Process_Info&) const override;
         size_t NSpins() const override { return 4; }
         bool FillNucleus(Event&, const std::vector<double>&) const override;
+        std::vector<std::shared_ptr<HadronicBeamMapper>> HadronicChannels(size_t) const override;
 
         // Required factory methods
         static std::unique_ptr<NuclearModel> Construct(const YAML::Node&);
@@ -103,9 +108,9 @@ class QESpectral : public NuclearModel, RegistrableNuclearModel<QESpectral> {
 
     private:
         bool b_ward{};
-        Current HadronicCurrent(const std::array<Spinor, 2>&, const std::array<Spinor, 2>&,
-                                const FourVector&, const FormFactorArray&) const;
+        Current HadronicCurrent(const NucleonBilinears&, const FormFactorArray&) const;
         SpectralFunction spectral_proton, spectral_neutron; 
+        std::shared_ptr<const SpectralSampler> m_sampler{};
 };
 
 }
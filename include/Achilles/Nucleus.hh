@@ -67,7 +67,7 @@ class Nucleus {
         /// @{
         /// These functions provide access to setting the parameters of the Nucleus object
 
-        /// Set the nucleons, protons, and neutrons of the nucleus
+        /// Set the nucleons of the nucleus, and update the locations of the protons and neutrons
         ///@param nucleons: The nucleons to be used for the nucleus
         void SetNucleons(Particles& _nucleons) noexcept;
 
@@ -112,31 +112,26 @@ class Nucleus {
 
         /// Return a vector of the ids of the protons in the nucleus
         ///@return std::vector<size_t>: The current ids of protons in nucleon vector 
-        std::vector<size_t> ProtonsIDs() noexcept { return protonLoc; }
+        const std::vector<size_t>& ProtonsIDs() const noexcept { return protonLoc; }
 
         /// Return a vector of the ids of the neutrons in the nucleus
         ///@return std::vector<size_t>: The current ids of neutrons in nucleon vector 
-        std::vector<size_t> NeutronsIDs() noexcept { return neutronLoc; }
+        const std::vector<size_t>& NeutronsIDs() const noexcept { return neutronLoc; }
 
-        /// Return a vector of the current protons
-        ///@return Particles: The current protons generated for the nucleus
-        Particles& Protons() noexcept { return protons; }
-
-        /// Return a vector of the current neutrons
-        ///@return Particles: The current neutrons generated for the nucleus
-        Particles& Neutrons() noexcept { return neutrons; }
-
-        /// Return the number of nucleons in the nucleus
+        /// Return the number of nucleons in the nucleus. This is the mass number, and does
+        /// not depend on the particles currently stored in the nucleon vector
         ///@return int: The number of nucleons in the nucleus
-        MOCK std::size_t NNucleons() const noexcept { return nucleons.size(); }
+        MOCK std::size_t NNucleons() const noexcept { return nprotons + nneutrons; }
 
-        /// Return the number of protons in the nucleus
+        /// Return the number of protons in the nucleus. The current protons are found
+        /// using Nucleons() together with ProtonsIDs()
         ///@return int: The number of protons in the nucleus
-        std::size_t NProtons() const noexcept { return protons.size(); }
+        MOCK std::size_t NProtons() const noexcept { return nprotons; }
 
-        /// Return the number of neutrons in the nucleus
+        /// Return the number of neutrons in the nucleus. The current neutrons are found
+        /// using Nucleons() together with NeutronsIDs()
         ///@return int: The number of neutrons in the nucleus
-        std::size_t NNeutrons() const noexcept { return neutrons.size(); }
+        MOCK std::size_t NNeutrons() const noexcept { return nneutrons; }
 
         /// Return the current binding energy of the nucleus
         ///@return double: The binding energy in MeV
@@ -236,13 +231,16 @@ class Nucleus {
         /// @}
 
     private:
-        Particles nucleons, protons, neutrons;
+        Particles nucleons;
+        std::size_t nprotons{}, nneutrons{};
         std::vector<size_t> protonLoc, neutronLoc;
         double binding{}, fermiMomentum{}, radius{};
         FermiGasType fermiGas{FermiGasType::Local};
         std::unique_ptr<Density> density;
         Interp1D rhoInterp;	
 
+        void UpdateLocations() noexcept;
+
         static const std::map<std::size_t, std::string> ZToName;
         static std::size_t NameToZ(const std::string&);
         PID m_pid;
@@ -0,0 +1,98 @@
+#ifndef PARALLEL_GZIP_HH
+#define PARALLEL_GZIP_HH
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace achilles {
+
+// Start of an independent gzip member, in bytes of the compressed file and of the
+// uncompressed data. Decompression can start at any frame
+struct GzipFrame {
+    uint64_t compressed{}, uncompressed{};
+};
+
+// Output stream buffer that compresses fixed-size blocks on a pool of threads,
+// following the approach of pigz. Each block is written as an independent gzip
+// member, and the members are written in order. Concatenated gzip members form a
+// valid gzip file, so the output can be read by gzip, zcat, zlib, and gzstream.
+class ParallelGzipBuf : public std::streambuf {
+    public:
+        static constexpr size_t block_default = 1 << 18;
+        static constexpr int level_default = 6;
+
+        ParallelGzipBuf(const std::string&, int level=level_default, size_t threads=1,
+                        size_t block=block_default);
+        ParallelGzipBuf(const ParallelGzipBuf&) = delete;
+        ParallelGzipBuf& operator=(const ParallelGzipBuf&) = delete;
+        ~ParallelGzipBuf() override;
+
+        bool IsOpen() const { return m_open; }
+        size_t NThreads() const { return m_workers.size(); }
+        // Frames written so far, used to build a seekable index of the file
+        const std::vector<GzipFrame>& Frames() const { return m_frames; }
+        // Compress the remaining data, write all blocks and close the file
+        void Close();
+
+    protected:
+        int_type overflow(int_type) override;
+        // Only writes out the blocks that are already compressed. Ending the current
+        // block on every flush would result in small blocks and poor compression
+        int sync() override;
+
+    private:
+        struct Block {
+            std::vector<char> input{}, output{};
+            size_t size{};
+            bool done{false}, failed{false};
+        };
+
+        bool Submit();
+        bool WriteReady(bool);
+        void Compress(Block&) const;
+        void Run();
+
+        std::ofstream m_file;
+        int m_level;
+        std::vector<char> m_buffer;
+        size_t m_max_blocks{};
+        bool m_open{false};
+
+        std::mutex m_mutex;
+        std::condition_variable m_work, m_done;
+        std::deque<std::shared_ptr<Block>> m_pending{}, m_order{};
+        bool m_stop{false};
+        std::vector<std::thread> m_workers{};
+        std::vector<GzipFrame> m_frames{};
+        GzipFrame m_position{};
+};
+
+class ParallelGzipStream : public std::ostream {
+    public:
+        ParallelGzipStream(const std::string &filename, int level=ParallelGzipBuf::level_default,
+                           size_t threads=1, size_t block=ParallelGzipBuf::block_default)
+            : std::ostream(nullptr), m_buf{filename, level, threads, block} {
+            rdbuf(&m_buf);
+            if(!m_buf.IsOpen()) setstate(std::ios::badbit);
+        }
+
+        void close() {
+            m_buf.Close();
+        }
+        const std::vector<GzipFrame>& Frames() const { return m_buf.Frames(); }
+
+    private:
+        ParallelGzipBuf m_buf;
+};
+
+}
+
+#endif
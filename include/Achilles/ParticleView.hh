@@ -0,0 +1,83 @@
+#ifndef PARTICLE_VIEW_HH
+#define PARTICLE_VIEW_HH
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "Achilles/Particle.hh"
+
+namespace achilles {
+
+// Non-owning view over two contiguous ranges of particles, used to iterate over the
+// hadrons followed by the leptons of an event without copying them. The view is only
+// valid as long as the underlying containers are not modified.
+class ParticleView {
+    public:
+        class const_iterator {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = Particle;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const Particle*;
+                using reference = const Particle&;
+
+                const_iterator() = default;
+                const_iterator(const Particle *current, const Particle *first_end, const Particle *second)
+                    : m_current{current}, m_first_end{first_end}, m_second{second} {}
+
+                reference operator*() const { return *m_current; }
+                pointer operator->() const { return m_current; }
+                const_iterator& operator++() {
+                    if(++m_current == m_first_end) m_current = m_second;
+                    return *this;
+                }
+                const_iterator operator++(int) {
+                    auto tmp = *this;
+                    ++(*this);
+                    return tmp;
+                }
+                bool operator==(const const_iterator &other) const { return m_current == other.m_current; }
+                bool operator!=(const const_iterator &other) const { return m_current != other.m_current; }
+
+            private:
+                const Particle *m_current{nullptr}, *m_first_end{nullptr}, *m_second{nullptr};
+        };
+        using iterator = const_iterator;
+
+        ParticleView() = default;
+        ParticleView(const std::vector<Particle> &first)
+            : m_first{first.data()}, m_nfirst{first.size()} {}
+        ParticleView(const std::vector<Particle> &first, const std::vector<Particle> &second)
+            : m_first{first.data()}, m_second{second.data()},
+              m_nfirst{first.size()}, m_nsecond{second.size()} {}
+
+        size_t size() const { return m_nfirst + m_nsecond; }
+        bool empty() const { return size() == 0; }
+        const Particle& operator[](size_t i) const {
+            return i < m_nfirst ? m_first[i] : m_second[i - m_nfirst];
+        }
+
+        const_iterator begin() const {
+            if(empty()) return end();
+            if(m_nfirst == 0) return {m_second, nullptr, nullptr};
+            if(m_nsecond == 0) return {m_first, nullptr, nullptr};
+            return {m_first, m_first + m_nfirst, m_second};
+        }
+        const_iterator end() const {
+            if(m_nsecond > 0) return {m_second + m_nsecond, nullptr, nullptr};
+            if(m_nfirst > 0) return {m_first + m_nfirst, nullptr, nullptr};
+            return {};
+        }
+
+        // Copy of the particles, only needed if the particles must outlive the event
+        std::vector<Particle> Copy() const { return {begin(), end()}; }
+
+    private:
+        const Particle *m_first{nullptr}, *m_second{nullptr};
+        size_t m_nfirst{}, m_nsecond{};
+};
+
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define PHASE_SPACE_BUILDER
 
 #include "Achilles/Achilles.hh"
+#include "Achilles/ParticleInfo.hh"
 #include "Achilles/PhaseSpaceMapper.hh"
 
 namespace PHASIC {
@@ -11,14 +12,16 @@ namespace PHASIC {
 namespace achilles {
 
 class Beam;
+class HadronicBeamMapper;
 
 class PSBuilder {
     public:
         PSBuilder(size_t nlep=2, size_t nhad=2) 
             : m_nlep{nlep}, m_nhad{nhad} { phase_space = std::make_unique<PSMapper>(nlep, nhad); }
         MOCK ~PSBuilder() = default;
-        MOCK PSBuilder& Beam(std::shared_ptr<Beam>, const std::vector<double>&, size_t=1);
+        MOCK PSBuilder& Beam(std::shared_ptr<Beam>, const std::vector<double>&, size_t=1, PID=PID::undefined());
         MOCK PSBuilder& Hadron(const std::string&, const std::vector<double>&, size_t=0);
+        MOCK PSBuilder& HadronMapper(std::shared_ptr<HadronicBeamMapper>, const std::vector<double>&);
         MOCK PSBuilder& FinalState(const std::string&, const std::vector<double>&);
 #ifdef ENABLE_BSM
         MOCK PSBuilder& SherpaFinalState(const std::string&, const std::vector<double>&);
@@ -22,6 +22,7 @@ void VectorModule(py::module&);
 void ParticleInfoModule(py::module&);
 void ParticleModule(py::module&);
 void NucleusModule(py::module&);
+void EventReaderModule(py::module&);
 
 // Calculation Objects
 void InteractionsModule(py::module&);
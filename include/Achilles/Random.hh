@@ -9,8 +9,10 @@ namespace achilles {
 
 class Random {
     public:
+        // Each thread owns its own generator, such that worker threads can draw
+        // random numbers independently. Threads need to be seeded separately
         static Random Instance() {
-            static Random rand;
+            static thread_local Random rand;
             return rand;
         }
 
@@ -0,0 +1,88 @@
+#ifndef SERIALIZATION_HH
+#define SERIALIZATION_HH
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace achilles {
+
+namespace io {
+
+// Raw binary helpers used for checkpoints and cached tables. The data is written
+// in the native byte order, so files are only meant to be read back on the same
+// architecture that produced them.
+template<typename T>
+void WriteBinary(std::ostream &out, const T &value) {
+    static_assert(std::is_trivially_copyable_v<T>, "WriteBinary requires a trivially copyable type");
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Sizes are always stored as 64-bit integers, independent of the width of size_t
+inline void WriteSize(std::ostream &out, size_t size) {
+    const uint64_t value = size;
+    WriteBinary(out, value);
+}
+
+template<typename T>
+void WriteBinary(std::ostream &out, const std::vector<T> &values) {
+    static_assert(std::is_trivially_copyable_v<T>, "WriteBinary requires a trivially copyable type");
+    WriteSize(out, values.size());
+    out.write(reinterpret_cast<const char*>(values.data()),
+              static_cast<std::streamsize>(values.size()*sizeof(T)));
+}
+
+inline void WriteBinary(std::ostream &out, const std::string &value) {
+    WriteSize(out, value.size());
+    out.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+template<typename T>
+bool ReadBinary(std::istream &in, T &value) {
+    static_assert(std::is_trivially_copyable_v<T>, "ReadBinary requires a trivially copyable type");
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+template<typename T>
+bool ReadBinary(std::istream &in, std::vector<T> &values) {
+    static_assert(std::is_trivially_copyable_v<T>, "ReadBinary requires a trivially copyable type");
+    uint64_t size{};
+    if(!ReadBinary(in, size)) return false;
+    values.resize(size);
+    in.read(reinterpret_cast<char*>(values.data()),
+            static_cast<std::streamsize>(values.size()*sizeof(T)));
+    return static_cast<bool>(in);
+}
+
+inline bool ReadBinary(std::istream &in, std::string &value) {
+    uint64_t size{};
+    if(!ReadBinary(in, size)) return false;
+    value.resize(size);
+    in.read(value.data(), static_cast<std::streamsize>(size));
+    return static_cast<bool>(in);
+}
+
+// 64-bit FNV-1a hash, used to tag binary files with the inputs they were built from
+inline uint64_t Hash(const char *data, size_t size, uint64_t hash = 0xcbf29ce484222325) {
+    static constexpr uint64_t prime = 0x100000001b3;
+    for(size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= prime;
+    }
+    return hash;
+}
+
+inline uint64_t Hash(const std::string &data, uint64_t hash = 0xcbf29ce484222325) {
+    return Hash(data.data(), data.size(), hash);
+}
+
+}
+
+}
+
+#endif
@@ -31,9 +31,53 @@ class SpectralFunction {
         double norm{};
         std::vector<double> mom, energy, spectral;
         Interp1D overestimate;
+        // The tables are given on a regular grid, which allows for the allocation free
+        // evaluator. The general interpolator is only used for irregular tables
+        bool regular{};
+        RegularGridInterp2D grid;
         Interp2D func;
 };
 
+// Samples the initial nucleon momentum and removal energy according to the sum of the given
+// spectral functions, weighted by the phase space factor p^2. The density is constant within
+// each cell of the table, such that the momentum is sampled from a piecewise linear marginal
+// CDF and the energy from the CDF of the momentum cell. A fraction of the events is
+// distributed uniformly over the table, such that the density is non-zero everywhere.
+// All densities are with respect to dp dE.
+class SpectralSampler {
+    public:
+        SpectralSampler(const std::vector<const SpectralFunction*>&, double=1e-3);
+        explicit SpectralSampler(const SpectralFunction &func, double floor=1e-3)
+            : SpectralSampler(std::vector<const SpectralFunction*>{&func}, floor) {}
+
+        double MinMomentum() const { return m_mom.front(); }
+        double MaxMomentum() const { return m_mom.back(); }
+        double MinEnergy() const { return m_energy.front(); }
+        double MaxEnergy() const { return m_energy.back(); }
+
+        // Marginal distribution of the momentum
+        double MomentumCDF(double) const;
+        double MomentumDensity(double) const;
+        double SampleMomentum(double) const;
+
+        // Distribution of the removal energy for a given momentum
+        double EnergyCDF(double, double) const;
+        double EnergyDensity(double, double) const;
+        double SampleEnergy(double, double) const;
+
+        double Density(double p, double E) const { return MomentumDensity(p)*EnergyDensity(p, E); }
+
+    private:
+        size_t MomentumCell(double) const;
+        size_t EnergyCell(double) const;
+
+        std::vector<double> m_mom, m_energy;
+        // Probability of each momentum cell, and the CDF at the knots
+        std::vector<double> m_pprob, m_pcdf;
+        // Conditional probability of each energy cell, and the CDF at the knots, stored as (p cell, E knot)
+        std::vector<double> m_eprob, m_ecdf;
+};
+
 }
 
 #endif
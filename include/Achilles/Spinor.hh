@@ -3,6 +3,7 @@
 
 // Implementation of spinor classes closely related to that in Sherpa
 
+#include <array>
 #include <complex>
 #include <iostream>
 
@@ -297,6 +298,66 @@ SpinMatrix operator/(const SpinMatrix &m, const T& scale) {
     return m * (1.0/scale);
 }
 
+// Split real and imaginary storage of the Dirac matrices and spinors, used by the vectorized
+// kernels below. Matrices are stored column-major, such that a matrix-spinor product is a sum
+// of columns scaled by the spinor components
+struct SplitSpinor {
+    alignas(32) std::array<double, 4> re{};
+    alignas(32) std::array<double, 4> im{};
+
+    SplitSpinor() = default;
+    explicit SplitSpinor(const Spinor &spinor) {
+        for(size_t i = 0; i < 4; ++i) {
+            re[i] = spinor[i].real();
+            im[i] = spinor[i].imag();
+        }
+    }
+    std::complex<double> operator[](size_t i) const { return {re[i], im[i]}; }
+};
+
+struct SplitSpinMatrix {
+    alignas(32) std::array<double, 16> re{};
+    alignas(32) std::array<double, 16> im{};
+
+    SplitSpinMatrix() = default;
+    explicit SplitSpinMatrix(const SpinMatrix &mat) {
+        for(size_t row = 0; row < 4; ++row) {
+            for(size_t col = 0; col < 4; ++col) {
+                re[4*col + row] = mat[4*row + col].real();
+                im[4*col + row] = mat[4*row + col].imag();
+            }
+        }
+    }
+    std::complex<double> operator()(size_t row, size_t col) const {
+        return {re[4*col + row], im[4*col + row]};
+    }
+    // this += scale*other, for real scale factors
+    void AddScaled(const SplitSpinMatrix &other, double scale) {
+        for(size_t i = 0; i < 16; ++i) {
+            re[i] += scale*other.re[i];
+            im[i] += scale*other.im[i];
+        }
+    }
+};
+
+// Instruction sets available for the spinor kernels. The best supported one is selected at
+// runtime, and the scalar version is used on platforms without SIMD support
+enum class SimdLevel { scalar, sse2, avx2 };
+
+SimdLevel DetectSimd();
+SimdLevel ActiveSimd();
+// Select the kernels, limited to what the CPU supports. Not thread-safe, intended for testing
+SimdLevel UseSimd(SimdLevel);
+
+// M u
+SplitSpinor Multiply(const SplitSpinMatrix&, const SplitSpinor&);
+// ubar v, where the first spinor is already barred
+std::complex<double> Dot(const SplitSpinor&, const SplitSpinor&);
+// ubar M u
+inline std::complex<double> Bilinear(const SplitSpinor &ubar, const SplitSpinMatrix &mat, const SplitSpinor &u) {
+    return Dot(ubar, Multiply(mat, u));
+}
+
 }
 
 #endif
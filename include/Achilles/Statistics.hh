@@ -3,10 +3,13 @@
 
 #include <algorithm>
 #include <limits>
+#include <vector>
 
 #include <iostream>
 #include <cmath>
 
+#include "Achilles/Serialization.hh"
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wshadow"
 #include "yaml-cpp/yaml.h"
@@ -16,47 +19,55 @@ namespace achilles {
 
 using lim = std::numeric_limits<double>;
 
-// Class taken from: https://stackoverflow.com/q/3738349/9201027
+// Streaming estimate of a single percentile using a merging t-digest
+// (T. Dunning and O. Ertl, arXiv:1902.04023). The memory is bounded by the
+// compression parameter, which also controls the accuracy: the rank error of
+// the estimate scales roughly as q(1-q)/compression, so the extreme tails
+// used for unweighting are resolved best.
 class Percentile {
     public:
-        Percentile(double percentile) : m_percentile(percentile) {}
-
-        void Add(const double &x) {
-            if(m_lower.empty() || x <= m_lower.front()) {
-                m_lower.push_back(x);
-                std::push_heap(m_lower.begin(), m_lower.end(), std::less<>());
-            } else {
-                m_upper.push_back(x);
-                std::push_heap(m_upper.begin(), m_upper.end(), std::greater<>());
-            }
-
-            auto size = static_cast<size_t>(static_cast<double>(m_lower.size() + m_upper.size())*m_percentile) + 1;
-            if(m_lower.size() > size) {
-                std::pop_heap(m_lower.begin(), m_lower.end(), std::less<>());
-                m_upper.push_back(m_lower.back());
-                std::push_heap(m_upper.begin(), m_upper.end(), std::greater<>());
-                m_lower.pop_back();
-            } else if(m_lower.size() < size) {
-                std::pop_heap(m_upper.begin(), m_upper.end(), std::greater<>());
-                m_lower.push_back(m_upper.back());
-                std::push_heap(m_lower.begin(), m_lower.end(), std::less<>());
-                m_upper.pop_back();
-            }
-        }
+        static constexpr double compression_default = 200;
+
+        Percentile(double percentile, double compression = compression_default);
 
-        double Get() const { return m_lower.front(); }
+        void Add(const double &x) { Add(x, 1); }
+        void Add(double x, double weight);
+        // Combine with a digest filled independently (e.g. on another thread)
+        void Merge(const Percentile&);
+
+        double Get() const { return Quantile(m_percentile); }
+        double Quantile(double) const;
+        double Count() const { return m_total + m_unmerged; }
+        size_t Size() const { Compress(); return m_centroids.size(); }
         
         void Clear() {
-            m_lower.clear();
-            m_upper.clear();
+            m_centroids.clear();
+            m_buffer.clear();
+            m_total = m_unmerged = 0;
+            m_min = lim::max();
+            m_max = lim::lowest();
         }
 
+        // Binary checkpointing of the digest. The percentile and compression are
+        // set by the constructor and are not stored
+        void SaveState(std::ostream&) const;
+        bool LoadState(std::istream&);
+
     private:
-        double m_percentile;
-        std::vector<double> m_lower, m_upper;
+        struct Centroid {
+            double mean, weight;
+            bool operator<(const Centroid &other) const { return mean < other.mean; }
+        };
+        void Compress() const;
+        double ScaleFunction(double, double) const;
+
+        double m_percentile, m_compression;
+        double m_min{lim::max()}, m_max{lim::lowest()};
+        // The digest is compressed lazily, so the centroids are updated in const methods
+        mutable std::vector<Centroid> m_centroids, m_buffer;
+        mutable double m_total{}, m_unmerged{};
 };
 
-
 // Structure to hold moments
 class StatsData {
     public:
@@ -67,6 +78,20 @@ class StatsData {
         StatsData& operator=(StatsData&&) = default;
         ~StatsData() = default;
 
+        // Construct from an estimate of the mean and of its variance, used for
+        // estimators that are not a plain sample mean (e.g. stratified sampling)
+        static StatsData FromMoments(double calls, double finite_calls, double mean,
+                                     double variance, double min, double max) {
+            StatsData data;
+            data.n = calls;
+            data.n_finite = finite_calls;
+            data.sum = mean * calls;
+            data.sum2 = calls * (variance * (calls - 1) + mean * mean);
+            data.min = min;
+            data.max = max;
+            return data;
+        }
+
         double Variance() const { return (sum2/n - Mean()*Mean()) / (n - 1); }
 
         StatsData& operator+=(double x) {
@@ -115,6 +140,16 @@ class StatsData {
         }
         bool operator!=(const StatsData &other) const { return !(*this == other); }
 
+        // Binary checkpointing
+        void SaveState(std::ostream &out) const {
+            for(const auto &x : {n, min, max, sum, sum2, n_finite}) io::WriteBinary(out, x);
+        }
+        bool LoadState(std::istream &in) {
+            for(auto *x : {&n, &min, &max, &sum, &sum2, &n_finite})
+                if(!io::ReadBinary(in, *x)) return false;
+            return true;
+        }
+
         friend YAML::convert<achilles::StatsData>;
 
     private:
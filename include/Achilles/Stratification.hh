@@ -0,0 +1,73 @@
+#ifndef STRATIFICATION_HH
+#define STRATIFICATION_HH
+
+#include <iosfwd>
+#include <vector>
+
+namespace achilles {
+
+// Adaptive stratified sampling of the unit hypercube following VEGAS+
+// (G.P. Lepage, J.Comput.Phys. 439 (2021) 110386). The unit hypercube is divided
+// into nstrat^dims hypercubes, and the number of samples in each is adapted to
+// the spread of the integrand observed in that hypercube.
+class Stratification {
+    public:
+        Stratification() = default;
+        Stratification(size_t dims, size_t ncalls, double beta, size_t max_hypercubes);
+
+        // Rebuild the hypercubes for a new number of calls per iteration. The sampling
+        // density learned so far is carried over, while the training data is cleared
+        void Resize(size_t ncalls, size_t max_hypercubes);
+
+        size_t Dims() const { return m_dims; }
+        size_t NStrata() const { return m_nstrat; }
+        size_t NHypercubes() const { return m_probs.size(); }
+
+        // Number of samples to place in each hypercube for a fixed number of calls
+        std::vector<size_t> Allocate(size_t) const;
+        // Randomly select a hypercube with probability given by the allocation
+        size_t Select(double) const;
+        // Map uniform random numbers into the given hypercube
+        void Map(size_t, std::vector<double>&) const;
+        size_t FindHypercube(const std::vector<double>&) const;
+        size_t Stratum(double y) const {
+            const auto idx = static_cast<size_t>(y * static_cast<double>(m_nstrat));
+            return idx < m_nstrat ? idx : m_nstrat - 1;
+        }
+        // Sampling density of the given hypercube relative to uniform sampling
+        double Density(size_t hypercube) const {
+            return m_probs[hypercube] * static_cast<double>(m_probs.size());
+        }
+
+        // Adaptation
+        void AddTrainData(size_t hypercube, double val) {
+            m_sum[hypercube] += val;
+            m_sum2[hypercube] += val * val;
+            m_count[hypercube] += 1;
+        }
+        void AddTrainData2(size_t hypercube, double val2) {
+            m_sum2[hypercube] += val2;
+            m_count[hypercube] += 1;
+        }
+        // Update the allocation from the training data. If central is true, the
+        // variance within each hypercube is used (fixed allocation), otherwise
+        // the second moment is used (random hypercube selection)
+        void Adapt(bool central = true);
+
+        // Binary checkpointing
+        void SaveState(std::ostream&) const;
+        bool LoadState(std::istream&);
+
+    private:
+        void Reset();
+        void UpdateCumulative();
+
+        size_t m_dims{}, m_nstrat{1};
+        double m_beta{};
+        std::vector<double> m_probs{1}, m_cumulative{1};
+        std::vector<double> m_sum{0}, m_sum2{0}, m_count{0};
+};
+
+}
+
+#endif
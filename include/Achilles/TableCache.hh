@@ -0,0 +1,53 @@
+#ifndef TABLE_CACHE_HH
+#define TABLE_CACHE_HH
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace achilles {
+
+// Contents of a parsed data table, given as integer metadata and columns of values
+struct Table {
+    std::vector<int64_t> header{};
+    std::vector<std::vector<double>> columns{};
+};
+
+// Binary cache for tables that are parsed from text files. Each cache file is tagged with
+// a layout version, the kind of table, and a hash of the source file, such that it is rebuilt
+// whenever the source or the parser changes. Caches are stored next to the source file, or in
+// the directory given by SetDirectory or the ACHILLES_TABLE_CACHE environment variable.
+// Setting the environment variable to "off" disables the cache. Failing to write a cache is
+// not an error, the table is then parsed on every run.
+class TableCache {
+    public:
+        using Parser = std::function<Table(const std::string&)>;
+        static constexpr uint32_t version = 1;
+
+        // Load the table from the cache if it is valid, and otherwise parse the source file
+        // with the given parser and update the cache
+        static Table Load(const std::string&, const std::string&, const Parser&);
+        // Location of the cache for the given source file and kind of table
+        static std::string CachePath(const std::string&, const std::string&);
+
+        static void SetDirectory(const std::string &directory) { Settings().directory = directory; }
+        static const std::string& Directory() { return Settings().directory; }
+        static void Enable(bool enabled) { Settings().enabled = enabled; }
+        static bool Enabled() { return Settings().enabled; }
+
+    private:
+        struct CacheSettings {
+            bool enabled{true};
+            std::string directory{};
+        };
+        static CacheSettings& Settings();
+
+        static bool Read(const std::string&, const std::string&, uint64_t, Table&);
+        static bool Write(const std::string&, const std::string&, uint64_t, const Table&);
+        static uint64_t PayloadHash(const Table&);
+};
+
+}
+
+#endif
@@ -20,6 +20,10 @@ class Unweighter {
         virtual void AddEvent(const Event&) = 0;
         virtual bool AcceptEvent(Event&) = 0;
 
+        // Binary checkpointing of the state collected while optimizing the integrator
+        virtual void SaveState(std::ostream&) const {}
+        virtual bool LoadState(std::istream&) { return true; }
+
         double Efficiency() const { return static_cast<double>(m_accepted) / static_cast<double>(m_total); }
         size_t Accepted() const { return m_accepted; }
 
@@ -49,6 +53,8 @@ class PercentileUnweighter : public Unweighter, RegistrableUnweighter<Percentile
         PercentileUnweighter(const YAML::Node&);
         void AddEvent(const Event&) override;
         bool AcceptEvent(Event&) override;
+        void SaveState(std::ostream &out) const override { m_percentile.SaveState(out); }
+        bool LoadState(std::istream &in) override { return m_percentile.LoadState(in); }
 
         // Required factory methods
         static std::unique_ptr<Unweighter> Construct(const YAML::Node&);
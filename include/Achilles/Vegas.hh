@@ -15,6 +15,7 @@
 
 #include "Achilles/AdaptiveMap.hh"
 #include "Achilles/Statistics.hh"
+#include "Achilles/Stratification.hh"
 #include "Achilles/Random.hh"
 
 #include "spdlog/spdlog.h"
@@ -45,10 +46,16 @@ struct VegasParams {
     size_t ncalls{ncalls_default}, nrefine{nrefine_default};
     double rtol{rtol_default}, atol{atol_default}, alpha{alpha_default};
     size_t ninterations{nitn_default};
+    // Damping of the stratified sample allocation and the maximum number of hypercubes.
+    // Setting max_hypercubes to 1 disables the stratification
+    double beta{beta_default};
+    size_t max_hypercubes{max_hypercubes_default};
 
     static constexpr size_t nitn_default = 10, ncalls_default = 10000, nrefine_default = 5;
     static constexpr double alpha_default = 1.5, rtol_default = 1e-4, atol_default = 1e-4;
-    static constexpr size_t nparams = 6;
+    static constexpr double beta_default = 0.75;
+    static constexpr size_t max_hypercubes_default = 100000;
+    static constexpr size_t nparams = 8;
 };
 
 struct VegasSummary {
@@ -56,6 +63,21 @@ struct VegasSummary {
     StatsData sum_results;
 
     StatsData Result() const { return sum_results; }
+    void SaveState(std::ostream &out) const {
+        io::WriteSize(out, results.size());
+        for(const auto &result : results) result.SaveState(out);
+    }
+    bool LoadState(std::istream &in) {
+        uint64_t nresults{};
+        if(!io::ReadBinary(in, nresults)) return false;
+        results.resize(nresults);
+        sum_results = StatsData();
+        for(auto &result : results) {
+            if(!result.LoadState(in)) return false;
+            sum_results += result;
+        }
+        return true;
+    }
 };
 
 class Vegas {
@@ -68,7 +90,8 @@ class Vegas {
         };
 
         Vegas() = default;
-        Vegas(AdaptiveMap map, VegasParams _params) : grid{std::move(map)}, params{std::move(_params)} {}
+        Vegas(AdaptiveMap map, VegasParams _params) : grid{std::move(map)}, params{std::move(_params)},
+            strata{grid.Dims(), params.ncalls, params.beta, params.max_hypercubes} {}
 
         // Utilities
         void SetVerbosity(size_t v = 1) {
@@ -80,16 +103,24 @@ class Vegas {
         }
         AdaptiveMap Grid() const { return grid; }
         AdaptiveMap &Grid() { return grid; }
-        // bool Serialize(std::ostream &out) const {
-        //     
-        // }
+        const Stratification &Strata() const { return strata; }
+
+        // Binary checkpointing of the grid, parameters, and accumulated results
+        void SaveState(std::ostream&) const;
+        bool LoadState(std::istream&);
 
         // Training the integratvegor
         void operator()(const Func<double>&);
         void Optimize(const Func<double>&);
+        // Map uniform random numbers through a randomly selected hypercube and the grid.
+        // Returns the selected hypercube
+        size_t Sample(std::vector<double>&) const;
         double GenerateWeight(const std::vector<double>&) const;
+        void AddTrainData(size_t hypercube, double val2) { strata.AddTrainData2(hypercube, val2); }
         void Adapt(const std::vector<double>&);
         void Refine();
+        // Number of calls per iteration, which sets the size of the stratification
+        void SetCalls(size_t);
 
         // Generating fixed number of events
 
@@ -105,6 +136,7 @@ class Vegas {
         AdaptiveMap grid;
         VegasSummary summary;
         VegasParams params{};
+        Stratification strata{};
         Verbosity verbosity{Verbosity::normal};
 };
 
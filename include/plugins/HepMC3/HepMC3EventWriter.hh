@@ -14,15 +14,15 @@ namespace achilles {
 
 class HepMC3Writer : public EventWriter {
     public:
-        HepMC3Writer(const std::string &filename, bool zipped=true) 
-            : file{InitializeStream(filename, zipped)} {}
+        HepMC3Writer(const std::string &filename, bool zipped=true, int level=6, size_t threads=1)
+            : file{InitializeStream(filename, zipped, level, threads)} {}
         ~HepMC3Writer() override = default;
 
         void WriteHeader(const std::string&) override;
         void Write(const Event&) override;
 
     private:
-        static std::shared_ptr<std::ostream> InitializeStream(const std::string&, bool);
+        static std::shared_ptr<std::ostream> InitializeStream(const std::string&, bool, int, size_t);
         HepMC3::WriterAscii file;
         achilles::StatsData results;
 };
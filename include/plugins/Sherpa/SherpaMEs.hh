@@ -51,6 +51,8 @@ public:
    const double &mu2) const;
 
   MOCK std::vector<FormFactorInfo> FormFactors(int, int) const;
+  // PIDs of the bosons exchanged at a form factor vertex of the given hadron
+  MOCK std::vector<int> Bosons(int) const;
   double Coupling(const std::string&) const;
   void RegisterParticles() const;
 
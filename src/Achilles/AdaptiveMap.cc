@@ -5,6 +5,7 @@
 
 #include "Achilles/AdaptiveMap.hh"
 #include "Achilles/Random.hh"
+#include "Achilles/Serialization.hh"
 #include "Achilles/Utilities.hh"
 #include "spdlog/spdlog.h"
 
@@ -30,13 +31,31 @@ bool AdaptiveMap::Serialize(std::ostream &out) const {
     return true;
 }
 
+void AdaptiveMap::SaveState(std::ostream &out) const {
+    io::WriteSize(out, m_dims);
+    io::WriteSize(out, m_bins);
+    io::WriteBinary(out, m_hist);
+}
+
+bool AdaptiveMap::LoadState(std::istream &in) {
+    uint64_t dims{}, bins{};
+    if(!io::ReadBinary(in, dims) || !io::ReadBinary(in, bins)) return false;
+    std::vector<double> hist;
+    if(!io::ReadBinary(in, hist) || hist.size() != dims*(bins+1)) return false;
+
+    m_dims = dims;
+    m_bins = bins;
+    m_hist = std::move(hist);
+    return true;
+}
+
 size_t AdaptiveMap::FindBin(size_t dim, double x) const {
     const auto edges = Edges(dim);
     auto it = std::lower_bound(edges.begin(), edges.end(), x);
     return static_cast<size_t>(std::distance(edges.begin(), it))-1;
 }
 
-double AdaptiveMap::operator()(std::vector<double> &rans) {
+double AdaptiveMap::operator()(std::vector<double> &rans) const {
     double jacobian = 1.0;
     for(std::size_t i = 0; i < m_dims; ++i) {
         const auto position = rans[i] * static_cast<double>(m_bins);
@@ -0,0 +1,109 @@
+#include "Achilles/Analysis.hh"
+#include "Achilles/Event.hh"
+#include "Achilles/Logging.hh"
+#include "Achilles/Particle.hh"
+#include "Achilles/System.hh"
+
+#include "yaml-cpp/yaml.h"
+
+#include <dlfcn.h>
+
+#include <fstream>
+
+using achilles::Analysis;
+using achilles::AnalysisHandler;
+using achilles::FinalStateEnergy;
+
+FinalStateEnergy::FinalStateEnergy(const YAML::Node &node) {
+    for(const auto &pid : node["PIDs"].as<std::vector<int>>()) m_pids.emplace_back(pid);
+    const auto nbins = node["Bins"] ? node["Bins"].as<size_t>() : 100;
+    const auto range = node["Range"] ? node["Range"].as<std::vector<double>>() : std::vector<double>{0, 2000};
+    if(range.size() != 2 || range[0] >= range[1])
+        throw std::runtime_error("FinalStateEnergy: Range requires a lower and an upper limit");
+    for(const auto &pid : m_pids)
+        m_hists.emplace_back(nbins, range[0], range[1], fmt::format("{}_{}", Name(), pid.AsInt()));
+}
+
+std::unique_ptr<Analysis> FinalStateEnergy::Construct(const YAML::Node &node) {
+    return std::make_unique<FinalStateEnergy>(node);
+}
+
+void FinalStateEnergy::Process(const Event &event) {
+    for(const auto &particle : event.Particles()) {
+        if(!particle.IsFinal()) continue;
+        for(size_t i = 0; i < m_pids.size(); ++i) {
+            if(particle.ID() == m_pids[i]) m_hists[i].Fill(particle.E(), event.Weight());
+        }
+    }
+}
+
+void FinalStateEnergy::Finalize(double xsec, double sum_weights) {
+    if(sum_weights <= 0) return;
+    for(auto &hist : m_hists) hist.Scale(xsec/sum_weights);
+}
+
+void FinalStateEnergy::Save(const std::string &prefix) const {
+    for(const auto &hist : m_hists) {
+        std::ofstream out(prefix + hist.GetName() + ".txt");
+        hist.Save(&out);
+    }
+}
+
+AnalysisHandler::AnalysisHandler(const YAML::Node &node) {
+    if(node["Output"]) m_output = node["Output"].as<std::string>();
+    if(node["Libraries"]) {
+        for(const auto &library : node["Libraries"].as<std::vector<std::string>>())
+            LoadLibrary(library);
+    }
+
+    for(const auto &analysis : node["Analyses"]) {
+        const auto name = analysis["Name"].as<std::string>();
+        if(!AnalysisFactory::IsRegistered(name)) {
+            AnalysisFactory::Display();
+            throw std::runtime_error(fmt::format("AnalysisHandler: Analysis {} is not registered", name));
+        }
+        spdlog::info("AnalysisHandler: Running analysis {}", name);
+        m_analyses.push_back(AnalysisFactory::Initialize(name, analysis));
+    }
+}
+
+AnalysisHandler::~AnalysisHandler() {
+    m_analyses.clear();
+    for(auto *handle : m_handles) dlclose(handle);
+}
+
+void AnalysisHandler::LoadLibrary(const std::string &library) {
+    using namespace achilles::SystemVariables;
+    using namespace achilles::PathVariables;
+
+    // Loading the library registers its analyses with the factory
+    const std::string filename = libPrefix + library + libSuffix;
+    for(const auto &name : {library, buildLibs + filename, installLibs + filename}) {
+        if(void *handle = dlopen(name.c_str(), RTLD_NOW)) {
+            spdlog::info("AnalysisHandler: Loaded {}", name);
+            m_handles.push_back(handle);
+            return;
+        }
+    }
+    throw std::runtime_error(fmt::format("AnalysisHandler: Cannot open {}: {}", library, dlerror()));
+}
+
+void AnalysisHandler::Process(const Event &event) {
+    // Events arrive from several final state interaction workers, while the
+    // analyses themselves are not required to be thread-safe
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for(auto &analysis : m_analyses) analysis -> Process(event);
+    m_sum_weights += event.Weight();
+}
+
+void AnalysisHandler::Process(const std::vector<Event> &events) {
+    for(const auto &event : events) Process(event);
+}
+
+void AnalysisHandler::Finalize(double xsec) {
+    for(auto &analysis : m_analyses) analysis -> Finalize(xsec, SumWeights());
+}
+
+void AnalysisHandler::Save() const {
+    for(const auto &analysis : m_analyses) analysis -> Save(m_output);
+}
@@ -2,17 +2,20 @@
 #include "Achilles/FourVector.hh"
 #include "Achilles/Beams.hh"
 
+#include "fmt/format.h"
+
+#include <stdexcept>
+
 using achilles::BeamMapper;
+using achilles::BeamSpeciesMapper;
 
 void BeamMapper::GeneratePoint(std::vector<FourVector> &point, const std::vector<double> &rans) {
-    auto beam_id = *m_beam -> BeamIDs().begin();
-    point[m_idx] = m_beam -> Flux(beam_id, rans, Smin());
+    point[m_idx] = m_beam -> Flux(BeamID(), rans, Smin());
     Mapper<FourVector>::Print(__PRETTY_FUNCTION__, point, rans);
 }
 
 double BeamMapper::GenerateWeight(const std::vector<FourVector> &point, std::vector<double> &rans) {
-    auto beam_id = *m_beam -> BeamIDs().begin();
-    auto wgt = m_beam -> GenerateWeight(beam_id, point[m_idx], rans, Smin());
+    auto wgt = m_beam -> GenerateWeight(BeamID(), point[m_idx], rans, Smin());
     Mapper<FourVector>::Print(__PRETTY_FUNCTION__, point, rans);
     spdlog::trace("  Beam weight = {}", wgt);
     return 1.0/wgt;
@@ -22,3 +25,53 @@ double BeamMapper::GenerateWeight(const std::vector<FourVector> &point, std::vec
 size_t BeamMapper::NDims() const {
     return static_cast<size_t>(m_beam -> NVariables());
 }
+
+achilles::PID BeamMapper::BeamID() const {
+    if(m_pid != PID::undefined()) return m_pid;
+    return *m_beam -> BeamIDs().begin();
+}
+
+BeamSpeciesMapper::BeamSpeciesMapper(std::shared_ptr<Beam> beam, std::shared_ptr<BeamSelection> selection,
+                                     SpeciesMappers mappers)
+        : m_beam{std::move(beam)}, m_selection{std::move(selection)}, m_mappers{std::move(mappers)} {
+    if(m_mappers.empty())
+        throw std::runtime_error("BeamSpeciesMapper: Requires a mapper for at least one species");
+    for(const auto &mapper : m_mappers) {
+        if(mapper.second -> NDims() != m_mappers.begin() -> second -> NDims())
+            throw std::runtime_error(fmt::format("BeamSpeciesMapper: Species {} has {} dimensions, "
+                                                 "but {} were expected", mapper.first,
+                                                 mapper.second -> NDims(),
+                                                 m_mappers.begin() -> second -> NDims()));
+    }
+}
+
+void BeamSpeciesMapper::GeneratePoint(std::vector<FourVector> &point, const std::vector<double> &rans) {
+    m_selection -> pid = m_beam -> SelectBeam(rans[0]);
+    m_selection -> ran = rans[0];
+    const std::vector<double> species_rans(rans.begin() + 1, rans.end());
+    m_mappers.at(m_selection -> pid) -> GeneratePoint(point, species_rans);
+    Mapper<FourVector>::Print(__PRETTY_FUNCTION__, point, rans);
+}
+
+double BeamSpeciesMapper::GenerateWeight(const std::vector<FourVector> &point, std::vector<double> &rans) {
+    std::vector<double> species_rans(NDims() - 1);
+    const double wgt = m_mappers.at(m_selection -> pid) -> GenerateWeight(point, species_rans);
+    rans.resize(1);
+    rans[0] = m_selection -> ran;
+    rans.insert(rans.end(), species_rans.begin(), species_rans.end());
+    Mapper<FourVector>::Print(__PRETTY_FUNCTION__, point, rans);
+    spdlog::trace("  Species {} weight = {}", m_selection -> pid, wgt);
+    return wgt;
+}
+
+YAML::Node BeamSpeciesMapper::ToYAML() const {
+    YAML::Node result;
+    result["Name"] = "BeamSpecies";
+    for(const auto &mapper : m_mappers) {
+        YAML::Node species;
+        species["PID"] = static_cast<int>(mapper.first);
+        species["Mapper"] = mapper.second -> ToYAML();
+        result["Species"].push_back(species);
+    }
+    return result;
+}
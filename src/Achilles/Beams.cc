@@ -3,6 +3,7 @@
 #include "Achilles/Interpolation.hh"
 #include "Achilles/Utilities.hh"
 
+#include <algorithm>
 #include <fstream>
 
 #ifdef USE_ROOT
@@ -14,6 +15,13 @@ using achilles::Spectrum;
 
 Spectrum::Spectrum(const YAML::Node &node) {
     spdlog::debug("Loading spectrum flux");
+    if(node["Sampling"]) {
+        const auto sampling = node["Sampling"].as<std::string>();
+        if(sampling == "Flux") m_sample_flux = true;
+        else if(sampling == "Uniform") m_sample_flux = false;
+        else throw std::runtime_error(fmt::format("Beam::Spectrum: Invalid sampling {}, "
+                                                  "expected Flux or Uniform", sampling));
+    }
     if(node["Histogram"]) {
         std::string filename = node["Histogram"].as<std::string>();
         std::ifstream hist(filename.c_str());
@@ -83,11 +91,14 @@ Spectrum::Spectrum(const YAML::Node &node) {
             case flux_units::v_nb_POT_MeV:
                 use_width = false;
                 break;
+            case flux_units::unknown:
+                throw std::runtime_error("Beam::Spectrum: Invalid flux units");
         }
 
         for(size_t i = 0; i < heights.size(); ++i) {
-            double width = use_width ? edges[i+1] - edges[i] : 1;
-            m_flux_integral += width*heights[i];
+            const double width = edges[i+1] - edges[i];
+            m_flux_integral += (use_width ? width : 1)*heights[i];
+            m_flux_total += width*heights[i];
         }
         spdlog::trace("Flux integral = {}", m_flux_integral);
 
@@ -102,6 +113,7 @@ Spectrum::Spectrum(const YAML::Node &node) {
 
         Interp1D interp(bin_centers, heights, InterpolationType::Polynomial);
         interp.SetPolyOrder(1);
+        SetupSampling(bin_centers, heights);
 
         m_flux = [=](double x){ return interp(x); };
         m_min_energy = edges.front();
@@ -117,6 +129,7 @@ Spectrum::Spectrum(const YAML::Node &node) {
             double norm = node["ROOTHist"]["Norm"].as<double>();
             hist -> Scale(norm);
             m_flux_integral = hist -> Integral(use_width ? "width" : "");
+            m_flux_total = hist -> Integral("width");
             spdlog::trace("Flux Integral = {}", m_flux_integral);
             std::vector<double> bin_centers; //(static_cast<size_t>(hist -> GetNbinsX())+2);
             std::vector<double> heights; //(static_cast<size_t>(hist -> GetNbinsX())+2);
@@ -135,6 +148,7 @@ Spectrum::Spectrum(const YAML::Node &node) {
 
             Interp1D interp(bin_centers, heights, InterpolationType::Polynomial);
             interp.SetPolyOrder(1);
+            SetupSampling(bin_centers, heights);
 
             m_flux = [=](double x){ return interp(x); };
             m_min_energy = bin_centers.front();
@@ -203,6 +217,22 @@ void Spectrum::T2KHeader(std::ifstream &hist) {
     }
 }
 
+std::string Spectrum::Units() const {
+    switch(m_units) {
+        case flux_units::v_nb_POT_MeV:
+            return "v/nb/POT/MeV";
+        case flux_units::v_cm2_POT_MeV:
+            return "v/cm^2/POT/MeV";
+        case flux_units::v_cm2_POT_50MeV:
+            return "v/cm^2/POT/50MeV";
+        case flux_units::cm2_50MeV:
+            return "cm^{-2}/50MeV";
+        case flux_units::unknown:
+            return "unknown";
+    }
+    return "Undefined";
+}
+
 std::string Spectrum::Format() const {
     switch(m_format) {
         case FluxFormat::Achilles:
@@ -215,21 +245,82 @@ std::string Spectrum::Format() const {
     return "Undefined";
 }
 
-achilles::FourVector Spectrum::Flux(const std::vector<double> &ran, double smin) const {
+void Spectrum::SetupSampling(const std::vector<double> &knots, const std::vector<double> &heights) {
+    // The flux is linear between the knots, so the CDF is piecewise quadratic
+    m_knots = knots;
+    m_heights.resize(heights.size());
+    std::transform(heights.begin(), heights.end(), m_heights.begin(),
+                   [](double height) { return std::max(height, 0.0); });
+    m_cdf.assign(m_knots.size(), 0);
+    for(size_t i = 1; i < m_knots.size(); ++i) {
+        m_cdf[i] = m_cdf[i-1] + (m_knots[i] - m_knots[i-1])*(m_heights[i] + m_heights[i-1])/2;
+    }
+}
+
+double Spectrum::FluxCDF(double energy) const {
+    if(energy <= m_knots.front()) return 0;
+    if(energy >= m_knots.back()) return m_cdf.back();
+    const auto idx = static_cast<size_t>(std::distance(m_knots.begin(),
+                std::upper_bound(m_knots.begin(), m_knots.end(), energy))) - 1;
+    const double dx = energy - m_knots[idx];
+    const double slope = (m_heights[idx+1] - m_heights[idx])/(m_knots[idx+1] - m_knots[idx]);
+    return m_cdf[idx] + dx*(m_heights[idx] + slope*dx/2);
+}
+
+double Spectrum::InverseFluxCDF(double cdf) const {
+    if(cdf <= 0) return m_knots.front();
+    if(cdf >= m_cdf.back()) return m_knots.back();
+    auto idx = static_cast<size_t>(std::distance(m_cdf.begin(),
+                std::upper_bound(m_cdf.begin(), m_cdf.end(), cdf))) - 1;
+    // Skip over empty segments, which can not contain the energy
+    while(idx + 1 < m_cdf.size() - 1 && m_cdf[idx+1] <= cdf) ++idx;
+
+    // Solve h dx + slope dx^2 / 2 = target in the segment, using the form that is
+    // stable for small slopes
+    const double width = m_knots[idx+1] - m_knots[idx];
+    const double height = m_heights[idx];
+    const double slope = (m_heights[idx+1] - height)/width;
+    const double target = cdf - m_cdf[idx];
+    const double disc = std::max(height*height + 2*slope*target, 0.0);
+    double dx = height + std::sqrt(disc) > 0 ? 2*target/(height + std::sqrt(disc)) : 0;
+    dx = std::min(std::max(dx, 0.0), width);
+    return m_knots[idx] + dx;
+}
+
+double Spectrum::ThresholdEnergy(double smin) const {
     // TODO: Resolve this with a cut
     static constexpr double eps = 5;
     double min_energy = (sqrt(smin) - Constant::mN + eps)*m_energy_units;
-    min_energy = std::max(min_energy, m_min_energy);
+    return std::max(min_energy, m_min_energy);
+}
+
+achilles::FourVector Spectrum::Flux(const std::vector<double> &ran, double smin) const {
+    double min_energy = ThresholdEnergy(smin);
+    if(m_sample_flux) {
+        const double cdf_min = FluxCDF(min_energy);
+        const double cdf_range = m_cdf.back() - cdf_min;
+        if(cdf_range > 0) {
+            const double energy = InverseFluxCDF(cdf_min + ran[0]*cdf_range)/m_energy_units;
+            return {energy, 0, 0, energy};
+        }
+    }
     double delta_energy = m_max_energy - min_energy;
     double energy = (ran[0]*delta_energy + min_energy)/m_energy_units;
     return {energy, 0, 0, energy};
 }
 
 double Spectrum::GenerateWeight(const FourVector &beam, std::vector<double> &ran, double smin) const {
-    // TODO: Resolve this with a cut
-    static constexpr double eps = 5;
-    double min_energy = (sqrt(smin) - Constant::mN + eps)*m_energy_units;
-    min_energy = std::max(min_energy, m_min_energy);
+    double min_energy = ThresholdEnergy(smin);
+    if(m_sample_flux) {
+        // The generation density is the flux normalized above threshold, so the weight
+        // is the fraction of the flux above threshold
+        const double cdf_min = FluxCDF(min_energy);
+        const double cdf_range = m_cdf.back() - cdf_min;
+        if(cdf_range > 0) {
+            ran[0] = (FluxCDF(beam.E()*m_energy_units) - cdf_min)/cdf_range;
+            return cdf_range/m_flux_integral;
+        }
+    }
     double delta_energy = m_max_energy - min_energy;
     ran[0] = (beam.E()*m_energy_units - min_energy) / delta_energy;
     // double scale = 1;
@@ -267,4 +358,32 @@ achilles::Beam::Beam(BeamMap beams) : m_beams{std::move(beams)} {
         spdlog::debug("Beam with PID: {} created.", beam.first);
         m_pids.insert(beam.first);
     }
+
+    // The species are weighed by their integrated flux, which can only be compared for
+    // fluxes of the same type and units
+    for(const auto &beam : m_beams) {
+        const auto &first = m_beams.begin() -> second;
+        if(beam.second -> Type() != first -> Type() || beam.second -> Units() != first -> Units())
+            throw std::runtime_error(fmt::format("Beam with PID: {} has a {} flux in units of {}, "
+                                                 "while a {} flux in units of {} was expected",
+                                                 int(beam.first), beam.second -> Type(), beam.second -> Units(),
+                                                 first -> Type(), first -> Units()));
+    }
+
+    double total = 0;
+    for(const auto &beam : m_beams) total += beam.second -> FluxIntegral();
+    for(const auto &beam : m_beams) {
+        m_fractions[beam.first] = beam.second -> FluxIntegral()/total;
+        spdlog::debug("Beam with PID: {} has a fraction {} of the flux.", beam.first, m_fractions[beam.first]);
+    }
+}
+
+achilles::PID achilles::Beam::SelectBeam(double ran) const {
+    double sum = 0;
+    for(const auto &fraction : m_fractions) {
+        sum += fraction.second;
+        if(ran < sum) return fraction.first;
+    }
+    // Guard against rounding in the sum of the fractions
+    return m_fractions.rbegin() -> first;
 }
@@ -156,14 +156,21 @@ void Cascade::Reset() {
 }
 
 void Cascade::Evolve(achilles::Event *event, const std::size_t &maxSteps) {
+    // The spectator nucleons are only generated once they are needed
+    event -> GenerateConfig();
+
     // Set all propagating particles as kicked for the cascade
     for(size_t idx = 0; idx < event -> Hadrons().size(); ++idx) {
         if(event->Hadrons()[idx].Status() == ParticleStatus::propagating)
             SetKicked(idx);
     }
 
-    // Run the normal cascade
-    Evolve(event->CurrentNucleus(), maxSteps);
+    // Run the normal cascade. The cascade works on the nucleus, so the hadrons
+    // of the event are swapped in and out instead of being copied
+    auto nucleus = event->CurrentNucleus();
+    std::swap(nucleus -> Nucleons(), event -> Hadrons());
+    Evolve(nucleus, maxSteps);
+    std::swap(event -> Hadrons(), nucleus -> Nucleons());
 }
 
 void Cascade::Evolve(std::shared_ptr<Nucleus> nucleus, const std::size_t& maxSteps) {
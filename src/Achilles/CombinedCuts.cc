@@ -1,30 +1,64 @@
 #include "Achilles/CombinedCuts.hh"
 #include "Achilles/Particle.hh"
 
-bool achilles::CutCollection::EvaluateCuts(const std::vector<achilles::Particle> &parts) {
+bool achilles::CutCollection::EvaluateCuts(const achilles::ParticleView &parts) {
     ntot++;
-    bool result = true;
     spdlog::trace("Evaluating Cuts");
+
+    // Select the final state particles that have any cuts applied to them, such that
+    // background nucleons and particles without cuts are only visited once
+    m_selected.clear();
     for(size_t i = 0; i < parts.size(); ++i) {
-        spdlog::trace("Making cut for {}, status = {}", parts[i].ID(), parts[i].Status());
         if(!parts[i].IsFinal() && !parts[i].IsPropagating()) continue;
-        spdlog::trace("Making cut for {}", parts[i].ID());
+        const size_t slot = Slot(parts[i].ID());
+        if(slot != m_pids.size()) m_selected.emplace_back(i, slot);
+    }
+
+    for(size_t i = 0; i < m_selected.size(); ++i) {
+        const auto &part = parts[m_selected[i].first];
+        spdlog::trace("Making cut for {}", part.ID());
         // Single Particle Cuts
-        for(const auto &cut : one_part_cuts)
-            if(cut.Contains(parts[i].ID()))
-                result &= cut.MakeCut(parts[i].Momentum());
+        for(const auto &cut : m_one_plan[m_selected[i].second])
+            if(!one_part_cuts[cut].MakeCut(part.Momentum())) return false;
         
         // Two Particle Cuts
-        for(size_t j = i+1; j < parts.size(); ++j) {
-            if(!parts[j].IsFinal() && !parts[i].IsPropagating()) continue;
-            for(const auto &cut : two_part_cuts)
-                if(cut.Contains(parts[i].ID(), parts[j].ID()))
-                    result &= cut.MakeCut(parts[i].Momentum(), parts[j].Momentum());
+        for(size_t j = i+1; j < m_selected.size(); ++j) {
+            const auto &other = parts[m_selected[j].first];
+            const auto &plan = m_two_plan[m_selected[i].second*m_pids.size() + m_selected[j].second];
+            for(const auto &cut : plan)
+                if(!two_part_cuts[cut].MakeCut(part.Momentum(), other.Momentum())) return false;
         }
     }
 
-    if(result) npass++;
-    return result;
+    npass++;
+    return true;
+}
+
+size_t achilles::CutCollection::Slot(PID pid) const {
+    // Only a handful of PIDs have cuts, so a linear search is fastest
+    for(size_t i = 0; i < m_pids.size(); ++i)
+        if(m_pids[i] == pid) return i;
+    return m_pids.size();
+}
+
+void achilles::CutCollection::Compile() {
+    std::set<PID> pids;
+    for(const auto &cut : one_part_cuts) pids.insert(cut.m_pids.begin(), cut.m_pids.end());
+    for(const auto &cut : two_part_cuts) pids.insert(cut.m_pids.begin(), cut.m_pids.end());
+    m_pids.assign(pids.begin(), pids.end());
+
+    const size_t npids = m_pids.size();
+    m_one_plan.assign(npids, {});
+    m_two_plan.assign(npids*npids, {});
+    for(size_t i = 0; i < npids; ++i) {
+        for(size_t icut = 0; icut < one_part_cuts.size(); ++icut)
+            if(one_part_cuts[icut].Contains(m_pids[i])) m_one_plan[i].push_back(icut);
+        for(size_t j = 0; j < npids; ++j) {
+            for(size_t icut = 0; icut < two_part_cuts.size(); ++icut)
+                if(two_part_cuts[icut].Contains(m_pids[i], m_pids[j]))
+                    m_two_plan[i*npids + j].push_back(icut);
+        }
+    }
 }
 
 double achilles::CutCollection::CutEfficiency() const {
@@ -46,6 +80,7 @@ bool achilles::CutCollection::AddCut(const std::set<PID> &pids, std::unique_ptr<
         one_part_cuts.push_back(std::move(combined_cut));
     }
 
+    Compile();
     return true;
 }
 
@@ -63,5 +98,7 @@ bool achilles::CutCollection::AddCut(const std::set<PID> &pids, std::unique_ptr<
         combined_cut.m_cuts.push_back(std::move(cut));
         two_part_cuts.push_back(std::move(combined_cut));
     }
+
+    Compile();
     return true;
 }
@@ -4,6 +4,7 @@
 #include "Achilles/Particle.hh"
 #include "Achilles/ThreeVector.hh"
 #include "Achilles/Random.hh"
+#include "Achilles/TableCache.hh"
 #include "Achilles/Utilities.hh"
 
 #ifdef GZIP
@@ -16,39 +17,65 @@
 #endif
 
 achilles::DensityConfiguration::DensityConfiguration(const std::string &filename) {
-    // Load configuration
+    // Load configuration, stored in the table as the ids and positions of all nucleons
+    // followed by the weights of the configurations
+    auto table = TableCache::Load(filename, "DensityConfiguration", [](const std::string &name) {
 #ifdef GZIP
-    igzstream configs(filename.c_str());
+        igzstream configs(name.c_str());
 #else
-    std::ifstream configs(filename.c_str());
+        std::ifstream configs(name.c_str());
 #endif
-    std::string line;
-    std::getline(configs, line);
-    std::vector<std::string> tokens;
-    tokenize(line, tokens);
-    m_nnucleons = std::stoul(tokens[0]);
-    m_nconfigs = std::stoul(tokens[1]);
-    m_maxWgt = std::stod(tokens[2]);
-    m_minWgt = std::stod(tokens[3]);
+        std::string line;
+        std::getline(configs, line);
+        std::vector<std::string> tokens;
+        tokenize(line, tokens);
+        const auto nnucleons = std::stoul(tokens[0]);
+        const auto nconfigs = std::stoul(tokens[1]);
+
+        Table result;
+        result.header = {static_cast<int64_t>(nnucleons), static_cast<int64_t>(nconfigs)};
+        result.columns.resize(3);
+        result.columns[0] = {std::stod(tokens[2]), std::stod(tokens[3])};
+        auto &nucleons = result.columns[1];
+        auto &wgts = result.columns[2];
+        nucleons.reserve(4*nnucleons*nconfigs);
+        wgts.reserve(nconfigs);
+        for(size_t iconfig = 0; iconfig < nconfigs; ++iconfig) {
+            for(size_t inucleon = 0; inucleon < nnucleons; ++inucleon) {
+                tokens.clear();
+                std::getline(configs, line);
+                tokenize(line, tokens);
+                nucleons.push_back(tokens[0] == "1" ? 1 : 0);
+                nucleons.push_back(std::stod(tokens[1]));
+                nucleons.push_back(std::stod(tokens[2]));
+                nucleons.push_back(std::stod(tokens[3]));
+            }
+            std::getline(configs, line);
+            wgts.push_back(std::stod(line));
+            std::getline(configs, line);
+        }
+        configs.close();
+        return result;
+    });
 
+    m_nnucleons = static_cast<size_t>(table.header[0]);
+    m_nconfigs = static_cast<size_t>(table.header[1]);
+    m_maxWgt = table.columns[0][0];
+    m_minWgt = table.columns[0][1];
+    const auto &nucleons = table.columns[1];
+    m_configurations.reserve(m_nconfigs);
     for(size_t iconfig = 0; iconfig < m_nconfigs; ++iconfig) {
         Configuration config;
+        config.nucleons.reserve(m_nnucleons);
         for(size_t inucleon = 0; inucleon < m_nnucleons; ++inucleon) {
-            tokens.clear();
-            std::getline(configs, line);
-            tokenize(line, tokens);
-            auto pid = tokens[0] == "1" ? PID::proton() : PID::neutron();
-            auto pos = ThreeVector(std::stod(tokens[1]), std::stod(tokens[2]),
-                                   std::stod(tokens[3]));
+            const double *nucleon = &nucleons[4*(iconfig*m_nnucleons + inucleon)];
+            auto pid = nucleon[0] == 1 ? PID::proton() : PID::neutron();
+            auto pos = ThreeVector(nucleon[1], nucleon[2], nucleon[3]);
             config.nucleons.emplace_back(pid, FourVector(), pos);
         }
-        std::getline(configs, line);
-        config.wgt = std::stod(line);
-        std::getline(configs, line);
+        config.wgt = table.columns[2][iconfig];
         m_configurations.push_back(config);
     }
-
-    configs.close();
 }
 
 std::vector<achilles::Particle> achilles::DensityConfiguration::GetConfiguration() {
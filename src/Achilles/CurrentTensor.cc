@@ -0,0 +1,47 @@
+#include "Achilles/CurrentTensor.hh"
+
+#include "fmt/format.h"
+
+#include <stdexcept>
+
+using achilles::BosonSlots;
+using achilles::CurrentTensor;
+
+size_t BosonSlots::Add(int pid) {
+    const size_t slot = Slot(pid);
+    if(slot != npos) return slot;
+    if(m_size == max_bosons)
+        throw std::runtime_error(fmt::format("BosonSlots: Can not add boson {}, at most {} bosons are supported",
+                                             pid, max_bosons));
+    m_pids[m_size] = pid;
+    return m_size++;
+}
+
+void CurrentTensor::Reset(size_t nspins) {
+    if(nspins > max_spins)
+        throw std::runtime_error(fmt::format("CurrentTensor: Requested {} spin states, but at most {} are supported",
+                                             nspins, max_spins));
+    m_data.fill({});
+    m_nspins = nspins;
+    m_active = 0;
+}
+
+void CurrentTensor::Set(size_t slot, const Current &current) {
+    if(current.size() < m_nspins)
+        throw std::runtime_error(fmt::format("CurrentTensor: Expected {} spin states, but got {}",
+                                             m_nspins, current.size()));
+    for(size_t spin = 0; spin < m_nspins; ++spin) {
+        if(current[spin].size() != nlorentz)
+            throw std::runtime_error("CurrentTensor: Currents require 4 Lorentz components");
+        for(size_t mu = 0; mu < nlorentz; ++mu) m_data[Index(slot, spin, mu)] = current[spin][mu];
+    }
+    m_active |= 1U << slot;
+}
+
+void CurrentTensor::Pack(const BosonSlots &bosons, const std::map<int, Current> &currents, size_t nspins) {
+    Reset(nspins);
+    for(size_t slot = 0; slot < bosons.size(); ++slot) {
+        auto it = currents.find(bosons.PID(slot));
+        if(it != currents.end()) Set(slot, it -> second);
+    }
+}
@@ -0,0 +1,81 @@
+#include "Achilles/DiracAlgebra.hh"
+#include "Achilles/FourVector.hh"
+
+using achilles::DiracMatrices;
+using achilles::HelicityCurrent;
+using achilles::NucleonBilinears;
+
+DiracMatrices::DiracMatrices() {
+    for(size_t mu = 0; mu < 4; ++mu) {
+        gamma[mu] = SpinMatrix::GammaMu(mu);
+        gamma_gamma5[mu] = gamma[mu]*SpinMatrix::Gamma_5();
+        for(size_t nu = 0; nu < 4; ++nu) sigma[mu][nu] = SpinMatrix::SigmaMuNu(mu, nu);
+    }
+    pl = SpinMatrix::PL();
+    pr = SpinMatrix::PR();
+
+    split_gamma = Split(gamma);
+    split_gamma_gamma5 = Split(gamma_gamma5);
+    for(size_t mu = 0; mu < 4; ++mu) split_sigma[mu] = Split(sigma[mu]);
+}
+
+DiracMatrices::SplitVertex DiracMatrices::Split(const Vertex &vertex) {
+    SplitVertex result;
+    for(size_t mu = 0; mu < 4; ++mu) result[mu] = SplitSpinMatrix(vertex[mu]);
+    return result;
+}
+
+const DiracMatrices& DiracMatrices::Instance() {
+    static const DiracMatrices matrices;
+    return matrices;
+}
+
+HelicityCurrent achilles::Sandwich(const HelicitySpinors &ubar, const DiracMatrices::SplitVertex &vertex,
+                                   const HelicitySpinors &u) {
+    const std::array<SplitSpinor, 2> sbar{SplitSpinor(ubar[0]), SplitSpinor(ubar[1])};
+    const std::array<SplitSpinor, 2> su{SplitSpinor(u[0]), SplitSpinor(u[1])};
+    HelicityCurrent result{};
+    for(size_t mu = 0; mu < 4; ++mu) {
+        for(size_t j = 0; j < 2; ++j) {
+            // Gamma^mu u(h2) is shared by both barred spinors
+            const auto rhs = Multiply(vertex[mu], su[j]);
+            for(size_t i = 0; i < 2; ++i) result[2*i+j][mu] = Dot(sbar[i], rhs);
+        }
+    }
+    return result;
+}
+
+achilles::HelicitySpinors achilles::UBarSpinors(const FourVector &mom) {
+    return {UBarSpinor(-1, mom), UBarSpinor(1, mom)};
+}
+
+achilles::HelicitySpinors achilles::USpinors(const FourVector &mom) {
+    return {USpinor(-1, mom), USpinor(1, mom)};
+}
+
+NucleonBilinears::NucleonBilinears(const HelicitySpinors &ubar, const HelicitySpinors &u,
+                                   const FourVector &qVec) {
+    const auto &dirac = DiracMatrices::Instance();
+    m_vector = Sandwich(ubar, dirac.split_gamma, u);
+    m_axial = Sandwich(ubar, dirac.split_gamma_gamma5, u);
+
+    // sigma^{mu nu} q_nu, with the index lowered by the metric
+    DiracMatrices::SplitVertex sigma_q{};
+    for(size_t mu = 0; mu < 4; ++mu) {
+        sigma_q[mu].AddScaled(dirac.split_sigma[mu][0], qVec[0]);
+        for(size_t nu = 1; nu < 4; ++nu) sigma_q[mu].AddScaled(dirac.split_sigma[mu][nu], -qVec[nu]);
+    }
+    m_tensor = Sandwich(ubar, sigma_q, u);
+}
+
+HelicityCurrent NucleonBilinears::operator()(std::complex<double> f1, std::complex<double> f2,
+                                             std::complex<double> fa, double mass) const {
+    const std::complex<double> tensor = std::complex<double>(0, 1)*f2/(2*mass);
+    HelicityCurrent result{};
+    for(size_t hel = 0; hel < result.size(); ++hel) {
+        for(size_t mu = 0; mu < 4; ++mu) {
+            result[hel][mu] = f1*m_vector[hel][mu] + tensor*m_tensor[hel][mu] + fa*m_axial[hel][mu];
+        }
+    }
+    return result;
+}
@@ -4,12 +4,13 @@
 #include "Achilles/Beams.hh"
 #include "Achilles/NuclearModel.hh"
 
+#include <algorithm>
+
 using achilles::Event;
 
 Event::Event(std::shared_ptr<Nucleus> nuc,
              std::vector<FourVector> mom, double vwgt)
         : m_nuc{std::move(nuc)}, m_mom{std::move(mom)}, m_vWgt{std::move(vwgt)} {
-    m_nuc -> GenerateConfig();
     m_me.resize(m_nuc -> NNucleons());
 }
 
@@ -38,8 +39,10 @@ void Event::InitializeLeptons(const Process_Info &process) {
 
 void Event::InitializeHadrons(const Process_Info &process) {
     // Coherent scattering is handled inside the coherent class
-    if(ParticleInfo(process.m_states.begin()->first[0]).IsNucleus())
+    if(ParticleInfo(process.m_states.begin()->first[0]).IsNucleus()) {
+        m_config = true;
         return;
+    }
 
     // Get all hadronic momenta
     std::vector<FourVector> mom;
@@ -50,46 +53,70 @@ void Event::InitializeHadrons(const Process_Info &process) {
     }
 
     // TODO: Update to handle multiple initial and final state particles
-    // Initial state setup
-    size_t idx = SelectNucleon();
-    Particle &initial = m_nuc -> Nucleons()[idx];
-    initial.Momentum() = mom.front();
+    // Initial state setup. Only the species of the struck nucleon is needed here,
+    // the position is assigned when the configuration is generated
+    m_nucleon = SelectNucleon();
+    const auto id = m_nucleon < m_nuc -> NProtons() ? PID::proton() : PID::neutron();
+    Particle initial(id, mom.front());
     initial.Status() = ParticleStatus::initial_state;
 
     // Final state setup
     Particle final(process.m_states.at({initial.ID()})[0], mom.back(),
-                   initial.Position(), ParticleStatus::propagating);
-    m_nuc -> Nucleons().push_back(final);
+                   {}, ParticleStatus::propagating);
+    m_hadrons = {initial, final};
+    m_config = false;
+    m_deferred = true;
+}
+
+void Event::GenerateConfig() {
+    if(m_config) return;
+    m_config = true;
+
+    m_nuc -> GenerateConfig();
+    vParticles hard = std::move(m_hadrons);
+    m_hadrons = m_nuc -> Nucleons();
+    if(!m_deferred) return;
+    m_deferred = false;
+
+    // Place the hard scattering hadrons into the new configuration
+    const bool is_proton = hard[0].ID() == PID::proton();
+    const auto &locations = is_proton ? m_nuc -> ProtonsIDs() : m_nuc -> NeutronsIDs();
+    const size_t idx = is_proton ? m_nucleon : m_nucleon - m_nuc -> NProtons();
+    Particle &initial = m_hadrons[locations[idx]];
+    initial.Momentum() = hard[0].Momentum();
+    initial.Status() = hard[0].Status();
+    const auto position = initial.Position();
+    for(size_t i = 1; i < hard.size(); ++i) {
+        hard[i].SetPosition(position);
+        m_hadrons.push_back(hard[i]);
+    }
 }
 
 void Event::Finalize() {
+    GenerateConfig();
+    // Count and remove the background nucleons in a single pass, keeping the order of the others
     size_t nA = 0, nZ = 0;
-    for(auto it = m_nuc -> Nucleons().begin(); it != m_nuc -> Nucleons().end(); ) {
-        if(it -> Status() == ParticleStatus::background) {
-            if(it -> ID() == PID::proton()) nZ++;
-            nA++;
-            it = m_nuc -> Nucleons().erase(it);
-        } else {
-            ++it;
-        }
-    }
+    auto last = std::remove_if(m_hadrons.begin(), m_hadrons.end(), [&](const Particle &particle) {
+        if(particle.Status() != ParticleStatus::background) return false;
+        if(particle.ID() == PID::proton()) nZ++;
+        nA++;
+        return true;
+    });
+    m_hadrons.erase(last, m_hadrons.end());
 
     m_remnant = NuclearRemnant(nA, nZ);
 }
 
-achilles::vParticles Event::Particles() const {
-    vParticles result;
-    result.insert(result.end(), Hadrons().begin(), Hadrons().end());
-    result.insert(result.end(), m_leptons.begin(), m_leptons.end());
-    return result;
+achilles::ParticleView Event::Particles() const {
+    return {m_hadrons, m_leptons};
 }
 
 const achilles::vParticles& Event::Hadrons() const {
-    return m_nuc -> Nucleons();
+    return m_hadrons;
 }
 
 achilles::vParticles& Event::Hadrons() {
-    return m_nuc -> Nucleons();
+    return m_hadrons;
 }
 
 void Event::CalcWeight() {
@@ -123,6 +150,7 @@ std::vector<double> Event::EventProbs() const {
 }
 
 void Event::Rotate(const std::array<double,9>& rot_mat) {
-    for (auto& particle: m_nuc -> Nucleons()){ particle.Rotate(rot_mat); }
+    GenerateConfig();
+    for (auto& particle: m_hadrons){ particle.Rotate(rot_mat); }
     for (auto& particle: m_leptons){ particle.Rotate(rot_mat); }
 }
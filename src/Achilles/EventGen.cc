@@ -1,6 +1,8 @@
 #include "Achilles/EventGen.hh"
 #include "Achilles/Event.hh"
 #include "Achilles/EventWriter.hh"
+#include "Achilles/HDF5EventWriter.hh"
+#include "Achilles/ParallelGzip.hh"
 #include "Achilles/HardScatteringFactory.hh"
 #include "Achilles/HardScattering.hh"
 #include "Achilles/Logging.hh"
@@ -12,6 +14,7 @@
 #include "Achilles/ProcessInfo.hh"
 #include "Achilles/NuclearModel.hh"
 #include "Achilles/ComplexFmt.hh"
+#include "Achilles/Serialization.hh"
 #include "Achilles/Units.hh"
 
 // TODO: Turn this into a factory to reduce the number of includes
@@ -34,6 +37,18 @@
 
 #include "yaml-cpp/yaml.h"
 
+#include <array>
+#include <cstdio>
+
+namespace {
+
+// Checkpoint file layout version. Bump when the binary layout of the
+// integrator state changes
+constexpr uint32_t checkpoint_version = 3;
+constexpr std::array<char, 8> checkpoint_magic{'A', 'C', 'H', 'C', 'K', 'P', 'T', '\0'};
+
+}
+
 achilles::Channel<achilles::FourVector> BuildChannelTest(const YAML::Node &node, std::shared_ptr<achilles::Beam> beam) {
     achilles::Channel<achilles::FourVector> channel;
     channel.mapping = std::make_unique<achilles::QuasielasticTestMapper>(node, beam);
@@ -44,10 +59,10 @@ achilles::Channel<achilles::FourVector> BuildChannelTest(const YAML::Node &node,
 
 template<typename T>
 achilles::Channel<achilles::FourVector> BuildChannel(achilles::NuclearModel *model, size_t nlep, size_t nhad,
-                                                 std::shared_ptr<achilles::Beam> beam,
+                                                 std::shared_ptr<achilles::Beam> beam, achilles::PID pid,
                                                  const std::vector<double> &masses) {
     achilles::Channel<achilles::FourVector> channel;
-    channel.mapping = achilles::PSBuilder(nlep, nhad).Beam(beam, masses, 1)
+    channel.mapping = achilles::PSBuilder(nlep, nhad).Beam(beam, masses, 1, pid)
                                                    .Hadron(model -> PhaseSpace(), masses)
                                                    .FinalState(T::Name(), masses).build();
     achilles::AdaptiveMap map(channel.mapping -> NDims(), 2);
@@ -55,6 +70,21 @@ achilles::Channel<achilles::FourVector> BuildChannel(achilles::NuclearModel *mod
     return channel;
 }
 
+// Channel using a hadronic mapper provided by the nuclear model
+template<typename T>
+achilles::Channel<achilles::FourVector> BuildChannel(std::shared_ptr<achilles::HadronicBeamMapper> hadron,
+                                                 size_t nlep, size_t nhad,
+                                                 std::shared_ptr<achilles::Beam> beam, achilles::PID pid,
+                                                 const std::vector<double> &masses) {
+    achilles::Channel<achilles::FourVector> channel;
+    channel.mapping = achilles::PSBuilder(nlep, nhad).Beam(beam, masses, 1, pid)
+                                                   .HadronMapper(std::move(hadron), masses)
+                                                   .FinalState(T::Name(), masses).build();
+    achilles::AdaptiveMap map(channel.mapping -> NDims(), 2);
+    channel.integrator = achilles::Vegas(map, achilles::VegasParams{});
+    return channel;
+}
+
 #ifdef ENABLE_BSM
 template<typename T>
 achilles::Channel<achilles::FourVector> BuildChannelSherpa(achilles::NuclearModel *model, size_t nlep, size_t nhad,
@@ -72,25 +102,85 @@ achilles::Channel<achilles::FourVector> BuildChannelSherpa(achilles::NuclearMode
 }
 
 achilles::Channel<achilles::FourVector> BuildGenChannel(achilles::NuclearModel *model, size_t nlep, size_t nhad,
-                                                    std::shared_ptr<achilles::Beam> beam,
+                                                    std::shared_ptr<achilles::Beam> beam, achilles::PID pid,
                                                     std::unique_ptr<PHASIC::Channels> final_state,
                                                     const std::vector<double> &masses) {
     achilles::Channel<achilles::FourVector> channel;
-    channel.mapping = achilles::PSBuilder(nlep, nhad).Beam(beam, masses, 1)
+    channel.mapping = achilles::PSBuilder(nlep, nhad).Beam(beam, masses, 1, pid)
                                                    .Hadron(model -> PhaseSpace(), masses)
                                                    .GenFinalState(std::move(final_state)).build();
     achilles::AdaptiveMap map(channel.mapping -> NDims(), 2);
     channel.integrator = achilles::Vegas(map, achilles::VegasParams{});
     return channel;
 }
+
+achilles::Channel<achilles::FourVector> BuildGenChannel(std::shared_ptr<achilles::HadronicBeamMapper> hadron,
+                                                    size_t nlep, size_t nhad,
+                                                    std::shared_ptr<achilles::Beam> beam, achilles::PID pid,
+                                                    std::unique_ptr<PHASIC::Channels> final_state,
+                                                    const std::vector<double> &masses) {
+    achilles::Channel<achilles::FourVector> channel;
+    channel.mapping = achilles::PSBuilder(nlep, nhad).Beam(beam, masses, 1, pid)
+                                                   .HadronMapper(std::move(hadron), masses)
+                                                   .GenFinalState(std::move(final_state)).build();
+    achilles::AdaptiveMap map(channel.mapping -> NDims(), 2);
+    channel.integrator = achilles::Vegas(map, achilles::VegasParams{});
+    return channel;
+}
 #endif
 
+// Leptonic process for a beam species. The final states are either shared by all species,
+// or given for each species as a map from the beam PID to its final states
+achilles::Process_Info BeamProcess(const YAML::Node &node, achilles::PID pid) {
+    const auto model = node["Model"].as<std::string>();
+    std::vector<achilles::PID> final_states;
+    if(node["Final States"].IsMap()) {
+        const auto states = node["Final States"][static_cast<int>(pid)];
+        if(!states)
+            throw std::runtime_error(fmt::format("EventGen: No final states given for beam {}", pid));
+        final_states = states.as<std::vector<achilles::PID>>();
+    } else {
+        final_states = node["Final States"].as<std::vector<achilles::PID>>();
+    }
+    achilles::Process_Info info(model, final_states);
+    info.m_ids.insert(info.m_ids.begin(), pid);
+    return info;
+}
+
+// Merge the channels of all beam species into the channels of the mixed beam, where the
+// species is selected by an additional integration variable. Channels are matched by their
+// position, so each species needs to provide the same set of channels
+std::vector<achilles::Channel<achilles::FourVector>> CombineSpecies(
+        std::map<achilles::PID, std::vector<achilles::Channel<achilles::FourVector>>> channels,
+        std::shared_ptr<achilles::Beam> beam, std::shared_ptr<achilles::BeamSelection> selection) {
+    const size_t nchannels = channels.begin() -> second.size();
+    for(const auto &species : channels) {
+        if(species.second.size() != nchannels)
+            throw std::runtime_error(fmt::format("EventGen: Beam {} has {} channels, but {} were expected",
+                                                 species.first, species.second.size(), nchannels));
+        if(beam -> at(species.first) -> NVariables() != beam -> NVariables())
+            throw std::runtime_error("EventGen: All species of a mixed beam need the same type of flux");
+    }
+
+    std::vector<achilles::Channel<achilles::FourVector>> result;
+    for(size_t i = 0; i < nchannels; ++i) {
+        achilles::BeamSpeciesMapper::SpeciesMappers mappers;
+        for(auto &species : channels) mappers[species.first] = std::move(species.second[i].mapping);
+        achilles::Channel<achilles::FourVector> channel;
+        channel.mapping = std::make_unique<achilles::BeamSpeciesMapper>(beam, selection, std::move(mappers));
+        achilles::AdaptiveMap map(channel.mapping -> NDims(), 2);
+        channel.integrator = achilles::Vegas(map, achilles::VegasParams{});
+        result.push_back(std::move(channel));
+    }
+    return result;
+}
+
 achilles::EventGen::EventGen(const std::string &configFile,
                              std::vector<std::string> shargs) {
     config = YAML::LoadFile(configFile);
 
     // Setup random number generator
-    auto seed = static_cast<unsigned int>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    seed = static_cast<unsigned int>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
     if(config["Initialize"]["Seed"])
         if(config["Initialize"]["Seed"].as<int>() > 0)
             seed = config["Initialize"]["Seed"].as<unsigned int>();
@@ -121,20 +211,12 @@ achilles::EventGen::EventGen(const std::string &configFile,
     }
 
     // Initialize the lepton final states
+    // Each species of the beam has its own leptonic process, and all species are generated
+    // in the same run with the species selected according to the integrated fluxes
     spdlog::debug("Initializing the leptonic final states");
-    auto leptonicProcess = config["Process"].as<achilles::Process_Info>();
-    // TODO: Handle the beam initial state better
-    if(beam -> BeamIDs().size() > 1)
-        throw std::runtime_error("Multiple processes are not implemented yet. Please use only one beam.");
-    leptonicProcess.m_ids.insert(leptonicProcess.m_ids.begin(),
-                                 beam -> BeamIDs().begin(), beam -> BeamIDs().end());
-
-    // Initialize the nuclear model
-    spdlog::debug("Initializing nuclear model");
+    selection = std::make_shared<BeamSelection>();
+    selection -> pid = *beam -> BeamIDs().begin();
     const auto model_name = config["NuclearModel"]["Model"].as<std::string>();
-    auto nuclear_model = NuclearModelFactory::Initialize(model_name, config);
-    nuclear_model -> AllowedStates(leptonicProcess);
-    spdlog::debug("Process: {}", leptonicProcess);
 
 #ifdef ENABLE_BSM
     // Initialize sherpa processes
@@ -145,60 +227,101 @@ achilles::EventGen::EventGen(const std::string &configFile,
     shargs.push_back("MODEL=" + model);
     shargs.push_back("UFO_PARAM_CARD=" + param_card);
     sherpa -> Initialize(shargs);
-    spdlog::debug("Initializing leptonic currents");
-    if(!sherpa -> InitializeProcess(leptonicProcess)) {
-        spdlog::error("Cannot initialize hard process");
-        exit(1);
-    }
-    leptonicProcess.m_mom_map = sherpa -> MomentumMap(leptonicProcess.Ids());
 #else
     // Dummy call to remove unused error
     shargs.size();
-    leptonicProcess.m_mom_map[0] = leptonicProcess.Ids()[0];
-    leptonicProcess.m_mom_map[1] = leptonicProcess.Ids()[1];
-    leptonicProcess.m_mom_map[2] = leptonicProcess.Ids()[2];
-    leptonicProcess.m_mom_map[3] = leptonicProcess.Ids()[3];
 #endif
 
-    // Initialize hard cross-sections
-    spdlog::debug("Initializing hard interaction");
-    scattering = std::make_shared<HardScattering>();
-    scattering -> SetProcess(leptonicProcess);
+    for(const auto &pid : beam -> BeamIDs()) {
+        auto leptonicProcess = BeamProcess(config["Process"], pid);
+
+        // Initialize the nuclear model
+        spdlog::debug("Initializing nuclear model");
+        auto nuclear_model = NuclearModelFactory::Initialize(model_name, config);
+        nuclear_model -> AllowedStates(leptonicProcess);
+        spdlog::debug("Process: {}", leptonicProcess);
+
 #ifdef ENABLE_BSM
-    scattering -> SetSherpa(sherpa);
+        spdlog::debug("Initializing leptonic currents");
+        if(!sherpa -> InitializeProcess(leptonicProcess)) {
+            spdlog::error("Cannot initialize hard process");
+            exit(1);
+        }
+        leptonicProcess.m_mom_map = sherpa -> MomentumMap(leptonicProcess.Ids());
+#else
+        leptonicProcess.m_mom_map[0] = leptonicProcess.Ids()[0];
+        leptonicProcess.m_mom_map[1] = leptonicProcess.Ids()[1];
+        leptonicProcess.m_mom_map[2] = leptonicProcess.Ids()[2];
+        leptonicProcess.m_mom_map[3] = leptonicProcess.Ids()[3];
+#endif
+
+        // Initialize hard cross-sections
+        spdlog::debug("Initializing hard interaction");
+        auto scattering = std::make_shared<HardScattering>();
+        scattering -> SetProcess(leptonicProcess);
+#ifdef ENABLE_BSM
+        scattering -> SetSherpa(sherpa);
 #endif
-    scattering -> SetNuclear(std::move(nuclear_model));
+        scattering -> SetNuclear(std::move(nuclear_model));
+        scatterings[pid] = std::move(scattering);
+    }
 
     // Setup channels
     spdlog::debug("Initializing phase space");
-    std::vector<double> masses = scattering -> Process().Masses();
-    spdlog::trace("Masses = [{}]", fmt::join(masses.begin(), masses.end(), ", "));
     if(config["TestingPS"]) {
+        if(scatterings.size() > 1)
+            throw std::runtime_error("EventGen: The testing phase space only supports a single beam");
         Channel<FourVector> channel = BuildChannelTest(config["TestingPS"], beam);
         integrand.AddChannel(std::move(channel));
     } else {
+        std::map<PID, std::vector<Channel<FourVector>>> species_channels;
+        for(const auto &entry : scatterings) {
+            const auto pid = entry.first;
+            const auto &scattering = entry.second;
+            auto &channels = species_channels[pid];
+            std::vector<double> masses = scattering -> Process().Masses();
+            spdlog::trace("Masses = [{}]", fmt::join(masses.begin(), masses.end(), ", "));
 #ifndef ENABLE_BSM
-        if(scattering -> Process().Multiplicity() == 4) {
-            Channel<FourVector> channel0 = BuildChannel<TwoBodyMapper>(scattering -> Nuclear(), 2, 2,
-                                                                       beam, masses);
-            integrand.AddChannel(std::move(channel0));
-        } else {
-            const std::string error = fmt::format("Leptonic Tensor can only handle 2->2 processes without "
-                                                  "BSM being enabled. "
-                                                  "Got a 2->{} process", leptonicProcess.m_ids.size());
-            throw std::runtime_error(error);
-        }
+            if(scattering -> Process().Multiplicity() == 4) {
+                channels.push_back(BuildChannel<TwoBodyMapper>(scattering -> Nuclear(), 2, 2,
+                                                               beam, pid, masses));
+                for(auto &hadron : scattering -> Nuclear() -> HadronicChannels(0)) {
+                    channels.push_back(BuildChannel<TwoBodyMapper>(std::move(hadron), 2, 2,
+                                                                   beam, pid, masses));
+                }
+            } else {
+                const std::string error = fmt::format("Leptonic Tensor can only handle 2->2 processes without "
+                                                      "BSM being enabled. "
+                                                      "Got a 2->{} process",
+                                                      scattering -> Process().m_ids.size());
+                throw std::runtime_error(error);
+            }
 #else
-        auto channels = sherpa -> GenerateChannels(scattering -> Process().Ids());
+            for(auto & chan : sherpa -> GenerateChannels(scattering -> Process().Ids())) {
+                channels.push_back(BuildGenChannel(scattering -> Nuclear(), 
+                                                   scattering -> Process().m_ids.size(), 2,
+                                                   beam, pid, std::move(chan), masses));
+            }
+            // Each channel owns its hadronic mapper, as in the SM setup
+            const size_t nhadronic = scattering -> Nuclear() -> HadronicChannels(0).size();
+            for(size_t ihadron = 0; ihadron < nhadronic; ++ihadron) {
+                for(auto &chan : sherpa -> GenerateChannels(scattering -> Process().Ids())) {
+                    auto hadron = scattering -> Nuclear() -> HadronicChannels(0)[ihadron];
+                    channels.push_back(BuildGenChannel(std::move(hadron), scattering -> Process().m_ids.size(), 2,
+                                                       beam, pid, std::move(chan), masses));
+                }
+            }
+#endif
+        }
+
+        auto channels = species_channels.size() == 1 ? std::move(species_channels.begin() -> second)
+                                                     : CombineSpecies(std::move(species_channels),
+                                                                      beam, selection);
         size_t count = 0;
-        for(auto & chan : channels) {
-            Channel<FourVector> channel = BuildGenChannel(scattering -> Nuclear(), 
-                                                          scattering -> Process().m_ids.size(), 2,
-                                                          beam, std::move(chan), masses);
+        for(auto &channel : channels) {
             integrand.AddChannel(std::move(channel));
             spdlog::info("Adding Channel{}", count++);
         }
-#endif
     }
 
     // Setup Multichannel integrator
@@ -220,70 +343,202 @@ achilles::EventGen::EventGen(const std::string &configFile,
     // spdlog::info("Apply event cuts? {}", doEventCuts);
     // event_cuts = config["EventCuts"].as<achilles::CutCollection>();
 
+    // Run the final state interactions on separate threads if requested
+    if(config["Main"]["Threads"])
+        nthreads = config["Main"]["Threads"].as<size_t>();
+    if(config["Main"]["QueueDepth"])
+        queue_depth = config["Main"]["QueueDepth"].as<size_t>();
+
     // Setup outputs
     auto output = config["Main"]["Output"];
     bool zipped = true;
     if(output["Zipped"])
         zipped = output["Zipped"].as<bool>();
+    // Compressed output is written in independent blocks on a pool of threads
+    int level = ParallelGzipBuf::level_default;
+    size_t compression_threads = 1;
+    if(output["Level"])
+        level = output["Level"].as<int>();
+    if(output["Threads"])
+        compression_threads = output["Threads"].as<size_t>();
     spdlog::trace("Outputing as {} format", output["Format"].as<std::string>());
-    if(output["Format"].as<std::string>() == "Achilles") {
-        writer = std::make_unique<AchillesWriter>(output["Name"].as<std::string>(), zipped);
+    std::unique_ptr<EventWriter> format_writer;
+    if(output["Format"].as<std::string>() == "None") {
+        // Writing events can be disabled if only the in-process analyses are needed
+        spdlog::info("Event output is disabled");
+    } else if(output["Format"].as<std::string>() == "Achilles") {
+        format_writer = std::make_unique<AchillesWriter>(output["Name"].as<std::string>(), zipped,
+                                                         level, compression_threads);
+    } else if(output["Format"].as<std::string>() == "HDF5") {
+        const unsigned int compression = zipped ? static_cast<unsigned int>(level) : 0;
+        format_writer = std::make_unique<HDF5Writer>(output["Name"].as<std::string>(), compression);
 #ifdef ENABLE_HEPMC3
     } else if(output["Format"].as<std::string>() == "HepMC3") {
-        writer = std::make_unique<HepMC3Writer>(output["Name"].as<std::string>(), zipped);
+        format_writer = std::make_unique<HepMC3Writer>(output["Name"].as<std::string>(), zipped,
+                                                       level, compression_threads);
 #endif
     } else {
         std::string msg = fmt::format("Achilles: Invalid output format requested {}",
                                       output["Format"].as<std::string>());
         throw std::runtime_error(msg);
     }
-    writer -> WriteHeader(configFile);
+
+    // Events with zero weight can be written in full, without particles, or skipped
+    if(output["ZeroWeight"]) {
+        const auto policy = output["ZeroWeight"].as<std::string>();
+        if(policy == "Write") zero_weight = ZeroWeightPolicy::write;
+        else if(policy == "Compact") zero_weight = ZeroWeightPolicy::compact;
+        else if(policy == "Skip") zero_weight = ZeroWeightPolicy::skip;
+        else throw std::runtime_error(fmt::format("Achilles: Invalid zero weight policy {}, "
+                                                  "expected Write, Compact, or Skip", policy));
+    }
+    if(format_writer) format_writer -> SetZeroWeightPolicy(zero_weight);
+
+    // Format and compress the events on a background thread if requested
+    bool async = false;
+    if(output["Async"])
+        async = output["Async"].as<bool>();
+    if(async && format_writer) {
+        size_t depth = 1024;
+        if(output["BufferDepth"])
+            depth = output["BufferDepth"].as<size_t>();
+        spdlog::info("Writing events asynchronously with a buffer of {} events", depth);
+        writer = std::make_unique<AsyncEventWriter>(std::move(format_writer), depth);
+    } else {
+        writer = std::move(format_writer);
+    }
+    if(writer) writer -> WriteHeader(configFile);
+
+    // Setup the in-process analyses
+    if(config["Analysis"])
+        analyses = std::make_unique<AnalysisHandler>(config["Analysis"]);
 }
 
 void achilles::EventGen::Initialize() {
-    // TODO: Clean up loading of previous results
     auto func = [&](const std::vector<FourVector> &mom, const double &wgt) {
         return GenerateEvent(mom, wgt);
     };
-    // TODO: Loading the saved data is broken
-    // try {
-    //     YAML::Node old_results = YAML::LoadFile("results.yml");
-    //     integrator = old_results["Multichannel"].as<MultiChannel>();
-    //     integrand = old_results["Channels"].as<Integrand<FourVector>>();
-    //     YAML::Node results;
-    //     results["Multichannel"] = integrator;
-    //     results["Channels"] = integrand;
-    //     integrand.Function() = func;
-    // } catch(const YAML::BadFile &e) {
-        spdlog::info("Initializing integrator.");
-        integrand.Function() = func;
-        if(config["Initialize"]["Accuracy"])
-            integrator.Parameters().rtol = config["Initialize"]["Accuracy"].as<double>();
-        integrator.Optimize(integrand);
-        integrator.Summary();
-
-        YAML::Node results;
-        results["Multichannel"] = integrator;
-        results["Channels"] = integrand;
-
-        std::ofstream fresults("results.yml");
-        fresults << results;
-        fresults.close();
-    // }
+    integrand.Function() = func;
+    if(config["Initialize"]["Checkpoint"])
+        checkpoint = config["Initialize"]["Checkpoint"].as<std::string>();
+
+    // Restore the grids from a previous run with the same physics setup if possible.
+    // A partially optimized checkpoint is continued from the last completed iteration
+    if(LoadCheckpoint()) spdlog::info("Loaded integrator state from {}.", checkpoint);
+    else spdlog::info("Initializing integrator.");
+
+    if(config["Initialize"]["Accuracy"])
+        integrator.Parameters().rtol = config["Initialize"]["Accuracy"].as<double>();
+    integrator.Optimize(integrand, [&]() { SaveCheckpoint(); });
+    integrator.Summary();
+
+    YAML::Node results;
+    results["Multichannel"] = integrator;
+    results["Channels"] = integrand;
+
+    std::ofstream fresults("results.yml");
+    fresults << results;
+    fresults.close();
+}
+
+uint64_t achilles::EventGen::ConfigHash() const {
+    // Only the sections that change the integrand or the unweighting are included, such
+    // that changing the number of events or the output does not invalidate the grids
+    uint64_t hash = io::Hash(std::to_string(checkpoint_version));
+    for(const auto &section : {"Beams", "Process", "NuclearModel", "Nucleus", "HardCuts", "TestingPS",
+                               "Unweighting"}) {
+        if(!config[section]) continue;
+        YAML::Emitter emitter;
+        emitter << config[section];
+        hash = io::Hash(section, hash);
+        hash = io::Hash(emitter.c_str(), hash);
+    }
+    if(config["Main"]["HardCuts"])
+        hash = io::Hash(config["Main"]["HardCuts"].as<std::string>(), hash);
+    return hash;
+}
+
+void achilles::EventGen::SaveCheckpoint() const {
+    // Write to a temporary file first so an interrupted write never corrupts
+    // the previous checkpoint
+    const std::string tmp = checkpoint + ".tmp";
+    std::ofstream out(tmp, std::ios::binary);
+    out.write(checkpoint_magic.data(), checkpoint_magic.size());
+    io::WriteBinary(out, checkpoint_version);
+    io::WriteBinary(out, ConfigHash());
+    integrator.SaveState(out);
+    integrand.SaveState(out);
+    // The unweighter is only trained while optimizing, so it is restored with the grids
+    unweighter -> SaveState(out);
+    out.close();
+    if(!out || std::rename(tmp.c_str(), checkpoint.c_str()) != 0)
+        spdlog::warn("EventGen: Failed to write checkpoint to {}", checkpoint);
+}
+
+bool achilles::EventGen::LoadCheckpoint() {
+    std::ifstream in(checkpoint, std::ios::binary);
+    if(!in) return false;
+
+    std::array<char, checkpoint_magic.size()> magic{};
+    uint32_t version{};
+    uint64_t hash{};
+    in.read(magic.data(), magic.size());
+    if(!in || magic != checkpoint_magic) {
+        spdlog::warn("EventGen: {} is not a valid checkpoint file", checkpoint);
+        return false;
+    }
+    if(!io::ReadBinary(in, version) || version != checkpoint_version) {
+        spdlog::info("EventGen: Checkpoint version mismatch, reoptimizing");
+        return false;
+    }
+    if(!io::ReadBinary(in, hash) || hash != ConfigHash()) {
+        spdlog::info("EventGen: Run card changed since checkpoint was written, reoptimizing");
+        return false;
+    }
+
+    // Only commit the loaded state if everything was read successfully
+    auto tmp_integrator = integrator;
+    std::vector<Vegas> grids;
+    for(const auto &channel : integrand.Channels()) grids.push_back(channel.integrator);
+    if(!integrator.LoadState(in) || !integrand.LoadState(in) || !unweighter -> LoadState(in)) {
+        spdlog::warn("EventGen: Checkpoint {} is corrupted, reoptimizing", checkpoint);
+        integrator = tmp_integrator;
+        for(size_t i = 0; i < grids.size(); ++i)
+            integrand.GetChannel(i).integrator = grids[i];
+        return false;
+    }
+    return true;
 }
 
 void achilles::EventGen::GenerateEvents() {
     outputEvents = true;
     runCascade = config["Cascade"]["Run"].as<bool>();
     integrator.Parameters().ncalls = config["Main"]["NEvents"].as<size_t>();
+    if(runCascade && nthreads > 0) {
+        std::vector<EventPipeline::Stage> stages;
+        for(size_t i = 0; i < nthreads; ++i) stages.push_back(BuildFSIStage());
+        pipeline = std::make_unique<EventPipeline>(std::move(stages), queue_depth,
+                                                   [&](const Event &event) { if(writer) writer -> Write(event); },
+                                                   seed);
+    }
     integrator(integrand);
     fmt::print("\n");
+    if(pipeline) {
+        pipeline -> Finish();
+        pipeline -> Report();
+        pipeline.reset();
+    }
     auto result = integrator.Summary();
     fmt::print("Integral = {:^8.5e} +/- {:^8.5e} ({:^8.5e} %)\n",
                result.results.back().Mean(), result.results.back().Error(),
                result.results.back().Error() / result.results.back().Mean()*100);
     fmt::print("Unweighting efficiency: {:^8.5e} %\n",
                unweighter->Efficiency() * 100);
+
+    if(analyses) {
+        analyses -> Finalize(result.results.back().Mean());
+        analyses -> Save();
+    }
 }
 
 double achilles::EventGen::GenerateEvent(const std::vector<FourVector> &mom, const double &wgt) {
@@ -299,7 +554,8 @@ double achilles::EventGen::GenerateEvent(const std::vector<FourVector> &mom, con
     // and initializes the beam particle for the event
     Event event(nucleus, mom, wgt);
 
-    // Initialize the particle ids for the processes
+    // Initialize the particle ids for the process of the selected beam species
+    const auto &scattering = scatterings.at(selection -> pid);
     const auto pids = scattering -> Process().m_ids;
 
     // Setup flux value
@@ -324,7 +580,7 @@ double achilles::EventGen::GenerateEvent(const std::vector<FourVector> &mom, con
             event.SetMEWeight(0);
             event.CalcWeight();
             spdlog::trace("Outputting the event");
-            writer -> Write(event);
+            WriteEvent(event);
             // Update number of calls needed to ensure the number of generated events
             // is the same as that requested by the user
             integrator.Parameters().ncalls++;
@@ -363,7 +619,7 @@ double achilles::EventGen::GenerateEvent(const std::vector<FourVector> &mom, con
             if(outputEvents) {
                 event.SetMEWeight(0);
                 event.CalcWeight();
-                writer -> Write(event);
+                WriteEvent(event);
                 // Update number of calls needed to ensure the number of generated events
                 // is the same as that requested by the user
                 integrator.Parameters().ncalls++;
@@ -372,8 +628,36 @@ double achilles::EventGen::GenerateEvent(const std::vector<FourVector> &mom, con
         }
     }
 
+    // During the optimization only the weight is needed
+    if(!outputEvents) {
+        unweighter->AddEvent(event);
+        return event.Weight();
+    }
+
+    // Unweight using the hard scattering weight. The final state interactions do
+    // not change the weight, so the cascade only needs to be run for accepted events
+    const bool accepted = unweighter->AcceptEvent(event);
+    if(!accepted) {
+        // Update number of calls needed to ensure the number of generated events
+        // is the same as that requested by the user
+        integrator.Parameters().ncalls++;
+
+        // Rejected events are not written in full, so the nucleon configuration is never needed
+        if(zero_weight != ZeroWeightPolicy::write) {
+            WriteEvent(event);
+            return event.Weight();
+        }
+    }
+
+    // Hand accepted events over to the final state interaction workers
+    if(pipeline && accepted) {
+        const double weight = event.Weight();
+        pipeline -> Push(std::move(event));
+        return weight;
+    }
+
     // Run the cascade if needed
-    if(runCascade) {
+    if(runCascade && accepted) {
         spdlog::trace("Hadrons:");
         idx = 0;
         for(const auto &particle : event.Hadrons()) {
@@ -391,7 +675,7 @@ double achilles::EventGen::GenerateEvent(const std::vector<FourVector> &mom, con
             spdlog::trace("\t{}: {}", ++idx, particle);
         }
     } else {
-        for(auto & nucleon : event.CurrentNucleus()->Nucleons()) {
+        for(auto & nucleon : event.Hadrons()) {
             if(nucleon.Status() == ParticleStatus::propagating) {
                 nucleon.Status() = ParticleStatus::final_state;
             }
@@ -399,29 +683,21 @@ double achilles::EventGen::GenerateEvent(const std::vector<FourVector> &mom, con
     }
 
     // Write out events
-    if(outputEvents) {
-        // Rotate cuts into plane of outgoing electron before writing
-        if (doRotate)
-            Rotate(event);
-        // Perform event-level final cuts before writing
-        bool outputCurrentEvent = true;
-        // if(doEventCuts){
-        //     spdlog::debug("Making event cuts");
-        //     outputCurrentEvent = MakeEventCuts(event);
-        // }
-
-        if(outputCurrentEvent) {
-            // Keep a running total of the number of surviving events
-            event.Finalize();
-            if(!unweighter->AcceptEvent(event)) {
-                // Update number of calls needed to ensure the number of generated events
-                // is the same as that requested by the user
-                integrator.Parameters().ncalls++;
-            }
-            writer -> Write(event);
-        }
-        } else {
-            unweighter->AddEvent(event);
+    // Rotate cuts into plane of outgoing electron before writing
+    if (doRotate)
+        Rotate(event);
+    // Perform event-level final cuts before writing
+    bool outputCurrentEvent = true;
+    // if(doEventCuts){
+    //     spdlog::debug("Making event cuts");
+    //     outputCurrentEvent = MakeEventCuts(event);
+    // }
+
+    if(outputCurrentEvent) {
+        event.Finalize();
+        // Rejected events are only written when requested, and should not change the analyses
+        if(analyses && accepted) analyses -> Process(event);
+        WriteEvent(event);
     }
 
     // Always return the weight when the event passes the initial hard cut.
@@ -430,6 +706,31 @@ double achilles::EventGen::GenerateEvent(const std::vector<FourVector> &mom, con
     return event.Weight();
 }
 
+achilles::EventPipeline::Stage achilles::EventGen::BuildFSIStage() {
+    // Each worker owns a nucleus and a cascade, since both are modified
+    // while propagating the hadrons
+    auto worker_nucleus = std::make_shared<Nucleus>(config["Nucleus"].as<Nucleus>());
+    auto potential_name = config["Nucleus"]["Potential"]["Name"].as<std::string>();
+    worker_nucleus -> SetPotential(PotentialFactory::Initialize(potential_name, worker_nucleus,
+                                                                config["Nucleus"]["Potential"]));
+    auto worker_cascade = std::make_shared<Cascade>(config["Cascade"].as<Cascade>());
+
+    return [this, worker_nucleus, worker_cascade](Event &event) {
+        // The nucleon configuration is generated lazily, so it is sampled with the worker nucleus
+        event.CurrentNucleus() = worker_nucleus;
+        worker_cascade -> Evolve(&event);
+        if(doRotate) Rotate(event);
+        event.Finalize();
+        if(analyses) analyses -> Process(event);
+    };
+}
+
+void achilles::EventGen::WriteEvent(Event &event) {
+    // Keep a single writer thread when running with the pipeline
+    if(pipeline) pipeline -> PushProcessed(std::move(event));
+    else if(writer) writer -> Write(event);
+}
+
 bool achilles::EventGen::MakeCuts(Event &event) {
     return hard_cuts.EvaluateCuts(event.Particles());
 }
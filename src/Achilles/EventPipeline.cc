@@ -0,0 +1,167 @@
+#include "Achilles/EventPipeline.hh"
+#include "Achilles/Event.hh"
+#include "Achilles/FourVector.hh"
+#include "Achilles/Particle.hh"
+#include "Achilles/Logging.hh"
+#include "Achilles/Random.hh"
+
+#include <stdexcept>
+
+using achilles::EventPipeline;
+using achilles::PipelineStageStats;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+int64_t Elapsed(clock_type::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start).count();
+}
+
+}
+
+EventPipeline::EventPipeline(std::vector<Stage> stages, size_t depth, Writer writer, unsigned int seed)
+        : m_fsi_queue{depth}, m_write_queue{depth}, m_stages{std::move(stages)},
+          m_writer{std::move(writer)}, m_active_workers{m_stages.size()}, m_start{clock_type::now()} {
+    if(m_stages.empty())
+        throw std::runtime_error("EventPipeline: At least one worker is required");
+
+    spdlog::info("EventPipeline: Running final state interactions on {} threads with queue depth {}",
+                 m_stages.size(), m_fsi_queue.Capacity());
+    // Each worker gets its own random stream, seeded deterministically from the main seed
+    for(size_t i = 0; i < m_stages.size(); ++i)
+        m_workers.emplace_back(&EventPipeline::RunWorker, this, std::ref(m_stages[i]),
+                               seed + static_cast<unsigned int>(i) + 1);
+    m_writer_thread = std::thread(&EventPipeline::RunWriter, this);
+}
+
+EventPipeline::~EventPipeline() {
+    try {
+        Finish();
+    } catch(const std::exception &e) {
+        spdlog::error("EventPipeline: {}", e.what());
+    }
+}
+
+void EventPipeline::Push(Event &&event) {
+    PushQueue(m_fsi_queue, std::make_unique<Event>(std::move(event)), m_producer, m_fsi);
+}
+
+void EventPipeline::PushProcessed(Event &&event) {
+    PushQueue(m_write_queue, std::make_unique<Event>(std::move(event)), m_producer, m_write);
+}
+
+void EventPipeline::Finish() {
+    if(m_finished) return;
+    m_finished = true;
+
+    m_producer_done.store(true, std::memory_order_release);
+    for(auto &worker : m_workers) worker.join();
+    m_writer_thread.join();
+    m_wall = static_cast<double>(Elapsed(m_start))*1e-9;
+
+    if(m_error) std::rethrow_exception(m_error);
+}
+
+std::vector<PipelineStageStats> EventPipeline::Stats() const {
+    auto convert = [](const std::string &name, const StageCounters &counters) {
+        PipelineStageStats stats;
+        stats.name = name;
+        stats.processed = counters.processed.load();
+        stats.max_depth = counters.max_depth.load();
+        stats.busy = static_cast<double>(counters.busy.load())*1e-9;
+        stats.blocked = static_cast<double>(counters.blocked.load())*1e-9;
+        return stats;
+    };
+    return {convert("Producer", m_producer), convert("FSI", m_fsi), convert("Writer", m_write)};
+}
+
+void EventPipeline::Report() const {
+    const double wall = m_finished ? m_wall : static_cast<double>(Elapsed(m_start))*1e-9;
+    spdlog::info("EventPipeline: Wall time {:.2f} s", wall);
+    for(const auto &stage : Stats()) {
+        spdlog::info("  {:>8}: {:>10} events, {:^8.3e} events/s, busy {:.2f} s, "
+                     "blocked {:.2f} s, max input queue depth {}",
+                     stage.name, stage.processed, stage.Throughput(wall),
+                     stage.busy, stage.blocked, stage.max_depth);
+    }
+}
+
+void EventPipeline::RunWorker(Stage &stage, unsigned int seed) {
+    try {
+        Random::Instance().Seed(seed);
+        EventPtr event;
+        size_t idle = 0;
+        for(;;) {
+            // Load the flag before trying to pop, such that an empty queue after the
+            // producer finished really means that there is no more work
+            const bool done = m_producer_done.load(std::memory_order_acquire);
+            if(!m_fsi_queue.TryPop(event)) {
+                if(done || m_failed.load()) break;
+                QueueBackoff(idle);
+                continue;
+            }
+            idle = 0;
+
+            const auto start = clock_type::now();
+            stage(*event);
+            m_fsi.busy += Elapsed(start);
+            PushQueue(m_write_queue, std::move(event), m_fsi, m_write);
+        }
+    } catch(...) {
+        SetError(std::current_exception());
+    }
+    if(--m_active_workers == 0) m_workers_done.store(true, std::memory_order_release);
+}
+
+void EventPipeline::RunWriter() {
+    try {
+        EventPtr event;
+        size_t idle = 0;
+        for(;;) {
+            const bool done = m_workers_done.load(std::memory_order_acquire);
+            if(!m_write_queue.TryPop(event)) {
+                if(done) break;
+                QueueBackoff(idle);
+                continue;
+            }
+            idle = 0;
+
+            const auto start = clock_type::now();
+            m_writer(*event);
+            m_write.busy += Elapsed(start);
+            ++m_write.processed;
+        }
+    } catch(...) {
+        SetError(std::current_exception());
+    }
+}
+
+void EventPipeline::PushQueue(BoundedQueue<EventPtr> &queue, EventPtr event,
+                              StageCounters &from, StageCounters &to) {
+    if(m_failed.load()) std::rethrow_exception(m_error);
+
+    if(!queue.TryPush(std::move(event))) {
+        // Apply back-pressure until the next stage catches up
+        const auto start = clock_type::now();
+        size_t idle = 0;
+        while(!queue.TryPush(std::move(event))) {
+            if(m_failed.load()) throw std::runtime_error("EventPipeline: A pipeline stage failed");
+            QueueBackoff(idle);
+        }
+        from.blocked += Elapsed(start);
+    }
+    ++from.processed;
+    UpdateDepth(to, queue.Size());
+}
+
+void EventPipeline::SetError(std::exception_ptr error) {
+    std::lock_guard<std::mutex> lock(m_error_mutex);
+    if(!m_error) m_error = error;
+    m_failed.store(true);
+}
+
+void EventPipeline::UpdateDepth(StageCounters &counters, size_t depth) {
+    auto current = counters.max_depth.load(std::memory_order_relaxed);
+    while(depth > current && !counters.max_depth.compare_exchange_weak(current, depth)) {}
+}
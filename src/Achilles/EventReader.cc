@@ -0,0 +1,180 @@
+#include "Achilles/EventReader.hh"
+#include "Achilles/Serialization.hh"
+
+#include "fmt/format.h"
+
+#ifdef GZIP
+#include <zlib.h>
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <stdexcept>
+
+using achilles::EventIndex;
+using achilles::AchillesReader;
+
+namespace {
+
+constexpr uint32_t index_version = 1;
+constexpr std::array<char, 8> index_magic{'A', 'C', 'H', 'I', 'D', 'X', '\0', '\0'};
+constexpr std::string_view event_tag = "Event: ";
+
+}
+
+void EventIndex::Save(const std::string &filename) const {
+    std::ofstream out(filename, std::ios::binary);
+    out.write(index_magic.data(), index_magic.size());
+    io::WriteBinary(out, index_version);
+    io::WriteBinary(out, offsets);
+    io::WriteBinary(out, frames);
+    if(!out) throw std::runtime_error(fmt::format("EventIndex: Failed to write {}", filename));
+}
+
+bool EventIndex::Load(const std::string &filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if(!in) return false;
+
+    std::array<char, index_magic.size()> magic{};
+    uint32_t version{};
+    in.read(magic.data(), magic.size());
+    if(!in || magic != index_magic) return false;
+    if(!io::ReadBinary(in, version) || version != index_version) return false;
+
+    EventIndex index;
+    if(!io::ReadBinary(in, index.offsets) || !io::ReadBinary(in, index.frames)) return false;
+    *this = std::move(index);
+    return true;
+}
+
+AchillesReader::AchillesReader(const std::string &filename) {
+    m_fd = open(filename.c_str(), O_RDONLY);
+    if(m_fd < 0)
+        throw std::runtime_error(fmt::format("AchillesReader: Could not open {}", filename));
+    struct stat info{};
+    if(fstat(m_fd, &info) != 0) {
+        close(m_fd);
+        throw std::runtime_error(fmt::format("AchillesReader: Could not read {}", filename));
+    }
+    m_size = static_cast<size_t>(info.st_size);
+    if(m_size > 0) {
+        void *data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+        if(data == MAP_FAILED) {
+            close(m_fd);
+            throw std::runtime_error(fmt::format("AchillesReader: Could not map {}", filename));
+        }
+        m_data = static_cast<const char*>(data);
+    }
+    m_compressed = m_size >= 2 && static_cast<unsigned char>(m_data[0]) == 0x1f
+                               && static_cast<unsigned char>(m_data[1]) == 0x8b;
+
+    // Use the index written with the file if it matches the file
+    const bool loaded = m_index.Load(EventIndex::Filename(filename));
+    if(m_compressed) {
+        if(!loaded || m_index.frames.empty() || m_index.frames.back().compressed >= m_size) {
+            if(m_data) munmap(const_cast<char*>(m_data), m_size);
+            close(m_fd);
+            throw std::runtime_error(fmt::format("AchillesReader: Compressed file {} requires a valid index {}",
+                                                 filename, EventIndex::Filename(filename)));
+        }
+    } else if(!loaded || m_index.offsets.empty() || m_index.offsets.back() != m_size) {
+        BuildIndex();
+    }
+}
+
+AchillesReader::~AchillesReader() {
+    if(m_data) munmap(const_cast<char*>(m_data), m_size);
+    if(m_fd >= 0) close(m_fd);
+}
+
+std::string AchillesReader::Event(size_t event) const {
+    CheckEvent(event);
+    if(!m_compressed) return std::string(RawEvent(event));
+    return Inflate(m_index.offsets[event], m_index.offsets[event + 1]);
+}
+
+std::string_view AchillesReader::RawEvent(size_t event) const {
+    CheckEvent(event);
+    if(m_compressed)
+        throw std::runtime_error("AchillesReader: Raw access is only possible for uncompressed files");
+    const auto begin = m_index.offsets[event];
+    return {m_data + begin, m_index.offsets[event + 1] - begin};
+}
+
+std::pair<size_t, size_t> AchillesReader::Shard(size_t shard, size_t nshards) const {
+    if(nshards == 0 || shard >= nshards)
+        throw std::out_of_range(fmt::format("AchillesReader: Invalid shard {} of {}", shard, nshards));
+    const size_t nevents = NEvents();
+    return {shard * nevents / nshards, (shard + 1) * nevents / nshards};
+}
+
+void AchillesReader::BuildIndex() {
+    // Scan for the start of each event, which is always at the start of a line
+    m_index = EventIndex{};
+    const std::string_view data(m_data, m_size);
+    size_t pos = 0;
+    while(pos < data.size()) {
+        if(data.compare(pos, event_tag.size(), event_tag) == 0) m_index.offsets.push_back(pos);
+        pos = data.find('\n', pos);
+        if(pos == std::string_view::npos) break;
+        ++pos;
+    }
+    if(!m_index.offsets.empty()) m_index.offsets.push_back(m_size);
+}
+
+void AchillesReader::CheckEvent(size_t event) const {
+    if(event >= NEvents()) {
+        throw std::out_of_range(fmt::format("AchillesReader: Requested event {}, but file only has {} events",
+                                            event, NEvents()));
+    }
+}
+
+std::string AchillesReader::Inflate(uint64_t begin, uint64_t end) const {
+#ifdef GZIP
+    // Find the frame containing the start of the event
+    const auto &frames = m_index.frames;
+    auto it = std::upper_bound(frames.begin(), frames.end(), begin,
+                               [](uint64_t value, const GzipFrame &frame) {
+                                   return value < frame.uncompressed;
+                               });
+    size_t frame = static_cast<size_t>(std::distance(frames.begin(), it)) - 1;
+    const uint64_t start = frames[frame].uncompressed;
+
+    // Decompress frames until the end of the event is reached
+    std::string data;
+    for(; frame < frames.size() && start + data.size() < end; ++frame) {
+        const bool last = frame + 1 == frames.size();
+        const uint64_t compressed_end = last ? m_size : frames[frame + 1].compressed;
+        const uint64_t uncompressed_end = last ? m_index.offsets.back() : frames[frame + 1].uncompressed;
+        const size_t size = uncompressed_end - frames[frame].uncompressed;
+        const size_t previous = data.size();
+        data.resize(previous + size);
+
+        z_stream stream{};
+        // Window bits of 15 + 16 only accept gzip streams
+        static constexpr int window_bits = 15 + 16;
+        if(inflateInit2(&stream, window_bits) != Z_OK)
+            throw std::runtime_error("AchillesReader: Failed to initialize zlib");
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(m_data + frames[frame].compressed));
+        stream.avail_in = static_cast<uInt>(compressed_end - frames[frame].compressed);
+        stream.next_out = reinterpret_cast<Bytef*>(data.data() + previous);
+        stream.avail_out = static_cast<uInt>(size);
+        const int status = inflate(&stream, Z_FINISH);
+        const auto total = stream.total_out;
+        inflateEnd(&stream);
+        if(status != Z_STREAM_END || total != size)
+            throw std::runtime_error(fmt::format("AchillesReader: Corrupted frame {}", frame));
+    }
+    return data.substr(begin - start, end - begin);
+#else
+    (void)begin;
+    (void)end;
+    throw std::runtime_error("AchillesReader: Reading compressed files requires gzip support");
+#endif
+}
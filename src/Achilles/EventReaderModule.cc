@@ -0,0 +1,18 @@
+#include "Achilles/PyBindings.hh"
+#include "Achilles/EventReader.hh"
+
+using achilles::AchillesReader;
+
+void EventReaderModule(py::module &m) {
+    py::class_<AchillesReader, std::shared_ptr<AchillesReader>>(m, "AchillesReader", py::module_local())
+        .def(py::init<const std::string&>())
+        .def("__len__", &AchillesReader::NEvents)
+        .def("__getitem__", [](const AchillesReader &reader, size_t event) {
+                // Decompression does not touch Python objects, so the GIL can be released
+                py::gil_scoped_release release;
+                return reader.Event(event);
+            })
+        .def("shard", &AchillesReader::Shard)
+        .def_property_readonly("n_events", &AchillesReader::NEvents)
+        .def_property_readonly("compressed", &AchillesReader::Compressed);
+}
@@ -1,39 +1,178 @@
 #include "Achilles/EventWriter.hh"
 #include "Achilles/Event.hh"
+#include "Achilles/EventReader.hh"
 #include "Achilles/Particle.hh"
 #include "Achilles/Version.hh"
+#include "Achilles/FourVector.hh"
+#include "Achilles/Logging.hh"
 #include "fmt/format.h"
 
-achilles::AchillesWriter::AchillesWriter(const std::string &filename, bool zip) : toFile{true}, zipped{zip} {
+achilles::ZeroWeightPolicy achilles::EventWriter::Policy(const Event &event) const {
+    // Only query the weight if needed, since writing all events is the default
+    if(m_zero_weight == ZeroWeightPolicy::write || event.Weight() != 0) return ZeroWeightPolicy::write;
+    return m_zero_weight;
+}
+
+achilles::AchillesWriter::AchillesWriter(const std::string &filename, bool zip, int level, size_t threads)
+        : toFile{true}, zipped{zip}, m_filename{filename} {
 #ifdef GZIP
     if(zipped) {
-        std::string zipname = filename;
         if(filename.substr(filename.size() - 3) != ".gz")
-            zipname += std::string(".gz");
-        m_out = new ogzstream(zipname.c_str());
+            m_filename += std::string(".gz");
+        m_file = std::make_unique<ParallelGzipStream>(m_filename, level, threads);
     } else
+#else
+    (void)level;
+    (void)threads;
+#endif
+        m_file = std::make_unique<std::ofstream>(filename);
+    m_out = m_file.get();
+}
+
+achilles::AchillesWriter::~AchillesWriter() {
+    // Moved from writers no longer own a file
+    if(toFile && m_file) {
+        EventIndex index;
+        index.offsets = m_offsets;
+        index.offsets.push_back(m_bytes);
+#ifdef GZIP
+        if(zipped) {
+            // Closing flushes the remaining blocks, which throws if the compression failed
+            auto *stream = dynamic_cast<ParallelGzipStream*>(m_file.get());
+            try {
+                stream -> close();
+            } catch(const std::exception &e) {
+                spdlog::error("AchillesWriter: {}", e.what());
+                m_file.reset();
+                m_out = nullptr;
+                return;
+            }
+            index.frames = stream -> Frames();
+        } else {
+            dynamic_cast<std::ofstream*>(m_file.get()) -> close();
+        }
+#else
+        dynamic_cast<std::ofstream*>(m_file.get()) -> close();
 #endif
-        m_out = new std::ofstream(filename);
+        m_file.reset();
+
+        try {
+            index.Save(EventIndex::Filename(m_filename));
+        } catch(const std::exception &e) {
+            spdlog::warn("AchillesWriter: {}", e.what());
+        }
+    }
+    m_out = nullptr;
+}
+
+void achilles::AchillesWriter::WriteString(const std::string &data) {
+    m_out -> write(data.data(), static_cast<std::streamsize>(data.size()));
+    m_bytes += data.size();
 }
 
 void achilles::AchillesWriter::WriteHeader(const std::string &filename) {
-    *m_out << fmt::format("Achilles Version: {}\n", ACHILLES_VERSION);
-    *m_out << fmt::format("{0:-^40}\n\n", "");
+    std::string header = fmt::format("Achilles Version: {}\n", ACHILLES_VERSION);
+    header += fmt::format("{0:-^40}\n\n", "");
 
     std::ifstream input(filename);
     std::string line;
     while(std::getline(input, line)) {
-        *m_out << fmt::format("{}\n", line);
+        header += fmt::format("{}\n", line);
     }
-    *m_out << fmt::format("{0:-^40}\n\n", "");
+    header += fmt::format("{0:-^40}\n\n", "");
+    WriteString(header);
 }
 
 void achilles::AchillesWriter::Write(const Event &event) {
-    *m_out << fmt::format("Event: {}\n", ++nEvents);
-    *m_out << fmt::format("  Particles:\n");
+    // Skipped events still advance the event number, such that the number of trials
+    // can be recovered from the output
+    const auto policy = Policy(event);
+    ++nEvents;
+    if(policy == ZeroWeightPolicy::skip) return;
+
+    m_offsets.push_back(m_bytes);
+    std::string out = fmt::format("Event: {}\n", nEvents);
+    if(policy == ZeroWeightPolicy::compact) {
+        out += "  Weight: 0\n";
+        WriteString(out);
+        return;
+    }
+    out += fmt::format("  Particles:\n");
     for(const auto &part : event.Particles()) {
-        *m_out << fmt::format("  - {}\n", part);
+        out += fmt::format("  - {}\n", part);
+    }
+    out += fmt::format("  - {}\n", event.Remnant());
+    out += fmt::format("  Weight: {}\n", event.Weight());
+    WriteString(out);
+}
+
+achilles::AsyncEventWriter::AsyncEventWriter(std::unique_ptr<EventWriter> writer, size_t depth)
+        : m_writer{std::move(writer)}, m_buffer{depth} {
+    if(!m_writer)
+        throw std::runtime_error("AsyncEventWriter: Requires a writer to wrap");
+    m_thread = std::thread(&AsyncEventWriter::Run, this);
+}
+
+achilles::AsyncEventWriter::~AsyncEventWriter() {
+    m_done.store(true, std::memory_order_release);
+    m_thread.join();
+    if(m_failed.load()) {
+        try {
+            std::rethrow_exception(m_error);
+        } catch(const std::exception &e) {
+            spdlog::error("AsyncEventWriter: Failed to write events: {}", e.what());
+        }
+    }
+}
+
+void achilles::AsyncEventWriter::WriteHeader(const std::string &filename) {
+    // The header has to be written before any of the buffered events
+    Flush();
+    m_writer -> WriteHeader(filename);
+}
+
+void achilles::AsyncEventWriter::Write(const Event &event) {
+    CheckError();
+    auto copy = std::make_unique<Event>(event);
+    size_t idle = 0;
+    while(!m_buffer.TryPush(std::move(copy))) {
+        CheckError();
+        QueueBackoff(idle);
     }
-    *m_out << fmt::format("  - {}\n", event.Remnant());
-    *m_out << fmt::format("  Weight: {}\n", event.Weight());
+    ++m_pushed;
+}
+
+void achilles::AsyncEventWriter::Flush() {
+    size_t idle = 0;
+    while(m_written.load() != m_pushed.load()) {
+        CheckError();
+        QueueBackoff(idle);
+    }
+}
+
+void achilles::AsyncEventWriter::Run() {
+    std::unique_ptr<Event> event;
+    size_t idle = 0;
+    try {
+        for(;;) {
+            // Load the flag before trying to pop, such that all events pushed
+            // before destruction are written
+            const bool done = m_done.load(std::memory_order_acquire);
+            if(!m_buffer.TryPop(event)) {
+                if(done) break;
+                QueueBackoff(idle);
+                continue;
+            }
+            idle = 0;
+            m_writer -> Write(*event);
+            ++m_written;
+        }
+    } catch(...) {
+        m_error = std::current_exception();
+        m_failed.store(true);
+    }
+}
+
+void achilles::AsyncEventWriter::CheckError() {
+    if(m_failed.load()) std::rethrow_exception(m_error);
 }
@@ -4,6 +4,9 @@
 #include "fmt/format.h"
 #include "yaml-cpp/yaml.h"
 
+#include <algorithm>
+#include <cmath>
+
 
 achilles::FormFactor::Values achilles::FormFactor::operator()(double Q2) const {
     Values results;
@@ -190,3 +193,113 @@ void achilles::LovatoFormFactor::Evaluate(double Q2, FormFactor::Values &result)
     double x = sqrt(Q2)/Constant::HBARC;
     result.Fcoh = exp(-0.5*pow(b*x, 2))*(c[0]+c[1]*b*x+c[2]*pow(b*x, 2)+c[3]*pow(b*x, 3)+c[4]*pow(b*x, 4))/6.0;
 }
+
+// Tabulated Form Factor
+achilles::TabulatedFormFactor::TabulatedFormFactor(FFType type, const YAML::Node &config) {
+    const auto type_name = FFTypeToString(type);
+    const auto node = config[type_name];
+    if(!node)
+        throw std::runtime_error(fmt::format("TabulatedFormFactor: No {} form factor to tabulate", type_name));
+    const auto name = node["Form Factor"].as<std::string>();
+    if(name == Name())
+        throw std::runtime_error("TabulatedFormFactor: Can not tabulate a tabulated form factor");
+    m_form_factor = FormFactorFactory::Initialize(name, FFType{type}, config[name]);
+
+    switch(type) {
+        case FFType::vector:
+            m_fields = {&FormFactor::Values::Gep, &FormFactor::Values::Gen,
+                        &FormFactor::Values::Gmp, &FormFactor::Values::Gmn,
+                        &FormFactor::Values::F1p, &FormFactor::Values::F1n,
+                        &FormFactor::Values::F2p, &FormFactor::Values::F2n};
+            break;
+        case FFType::axial:
+            m_fields = {&FormFactor::Values::FA, &FormFactor::Values::FAs};
+            break;
+        case FFType::coherent:
+            m_fields = {&FormFactor::Values::Fcoh};
+            break;
+    }
+
+    m_q2min = node["Q2 Min"] ? node["Q2 Min"].as<double>() : 0;
+    m_q2max = node["Q2 Max"].as<double>();
+    if(m_q2max <= m_q2min)
+        throw std::runtime_error("TabulatedFormFactor: Q2 Max has to be larger than Q2 Min");
+    // The accuracy can be set for each type or for all types at once
+    const auto setting = [&](const std::string &key) { return node[key] ? node[key] : config[key]; };
+    const double tolerance = setting("Tolerance") ? setting("Tolerance").as<double>() : 1e-6;
+    const size_t max_points = setting("Max Points") ? setting("Max Points").as<size_t>() : (1UL << 20) + 1;
+
+    // Double the number of intervals until the deviation is small enough
+    static constexpr size_t min_intervals = 64;
+    size_t intervals = min_intervals;
+    do {
+        Tabulate(intervals + 1);
+        m_max_deviation = Deviation();
+        intervals *= 2;
+    } while(m_max_deviation > tolerance && intervals + 1 <= max_points);
+
+    if(m_max_deviation > tolerance) {
+        spdlog::warn("TabulatedFormFactor: Maximum deviation of {} for {} exceeds the tolerance of {} "
+                     "with {} points", m_max_deviation, name, tolerance, m_npoints);
+    } else {
+        spdlog::info("TabulatedFormFactor: Tabulated {} with {} points in [{}, {}], maximum deviation {}",
+                     name, m_npoints, m_q2min, m_q2max, m_max_deviation);
+    }
+}
+
+std::unique_ptr<achilles::FormFactorImpl> achilles::TabulatedFormFactor::Construct(achilles::FFType type,
+                                                                                   const YAML::Node &node) {
+    return std::make_unique<TabulatedFormFactor>(type, node);
+}
+
+void achilles::TabulatedFormFactor::Tabulate(size_t npoints) {
+    m_npoints = npoints;
+    m_step = (m_q2max - m_q2min)/static_cast<double>(npoints - 1);
+    m_table.resize(npoints*m_fields.size());
+    for(size_t i = 0; i < npoints; ++i) {
+        FormFactor::Values values;
+        const double q2 = m_q2min + static_cast<double>(i)*m_step;
+        m_form_factor -> Evaluate(q2, values);
+        for(size_t j = 0; j < m_fields.size(); ++j) {
+            if(!std::isfinite(values.*m_fields[j]))
+                throw std::runtime_error(fmt::format("TabulatedFormFactor: Form factor is not finite at Q2 = {}", q2));
+            m_table[i*m_fields.size() + j] = values.*m_fields[j];
+        }
+    }
+}
+
+double achilles::TabulatedFormFactor::Deviation() const {
+    // The interpolation error is largest between the grid points
+    double deviation = 0;
+    for(size_t i = 0; i + 1 < m_npoints; ++i) {
+        const double q2 = m_q2min + (static_cast<double>(i) + 0.5)*m_step;
+        FormFactor::Values exact, interpolated;
+        m_form_factor -> Evaluate(q2, exact);
+        Evaluate(q2, interpolated);
+        for(const auto &field : m_fields)
+            deviation = std::max(deviation, std::abs(exact.*field - interpolated.*field));
+    }
+    return deviation;
+}
+
+void achilles::TabulatedFormFactor::Evaluate(double Q2, FormFactor::Values &result) const {
+    if(Q2 < m_q2min || Q2 > m_q2max) {
+        m_form_factor -> Evaluate(Q2, result);
+        return;
+    }
+
+    // Cubic Lagrange interpolation on the four closest grid points. The weights are shared
+    // by all form factors
+    const double x = (Q2 - m_q2min)/m_step;
+    const size_t cell = std::min(static_cast<size_t>(x), m_npoints - 2);
+    const size_t start = cell == 0 ? 0 : std::min(cell - 1, m_npoints - 4);
+    const double t = x - static_cast<double>(start);
+    const std::array<double, 4> weights{-(t-1)*(t-2)*(t-3)/6, t*(t-2)*(t-3)/2,
+                                        -t*(t-1)*(t-3)/2, t*(t-1)*(t-2)/6};
+    const size_t nfields = m_fields.size();
+    const double *row = &m_table[start*nfields];
+    for(size_t j = 0; j < nfields; ++j) {
+        result.*m_fields[j] = weights[0]*row[j] + weights[1]*row[nfields + j]
+                            + weights[2]*row[2*nfields + j] + weights[3]*row[3*nfields + j];
+    }
+}
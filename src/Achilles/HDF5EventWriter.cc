@@ -0,0 +1,227 @@
+#include "Achilles/HDF5EventWriter.hh"
+#include "Achilles/Event.hh"
+#include "Achilles/FourVector.hh"
+#include "Achilles/Logging.hh"
+#include "Achilles/Particle.hh"
+#include "Achilles/Version.hh"
+
+#include <array>
+#include <fstream>
+#include <sstream>
+
+using achilles::HDF5Writer;
+using achilles::HDF5Reader;
+
+namespace {
+
+template<typename T>
+void Append(H5::DataSet &dataset, const std::vector<T> &data, const H5::PredType &type, hsize_t ncols=1) {
+    if(data.empty()) return;
+    const int rank = ncols > 1 ? 2 : 1;
+    std::array<hsize_t, 2> current{};
+    dataset.getSpace().getSimpleExtentDims(current.data());
+
+    const hsize_t nrows = data.size() / ncols;
+    std::array<hsize_t, 2> extent{current[0] + nrows, ncols};
+    dataset.extend(extent.data());
+
+    H5::DataSpace file_space = dataset.getSpace();
+    std::array<hsize_t, 2> offset{current[0], 0};
+    std::array<hsize_t, 2> count{nrows, ncols};
+    file_space.selectHyperslab(H5S_SELECT_SET, count.data(), offset.data());
+    H5::DataSpace memory_space(rank, count.data());
+    dataset.write(data.data(), type, memory_space, file_space);
+}
+
+template<typename T>
+std::vector<T> ReadAll(const H5::DataSet &dataset, const H5::PredType &type) {
+    H5::DataSpace space = dataset.getSpace();
+    std::array<hsize_t, 2> dims{1, 1};
+    space.getSimpleExtentDims(dims.data());
+    std::vector<T> data(static_cast<size_t>(dims[0]));
+    if(!data.empty()) dataset.read(data.data(), type, space, space);
+    return data;
+}
+
+H5::H5File OpenFile(const std::string &filename, unsigned int flags) {
+    try {
+        return H5::H5File(filename, flags);
+    } catch(const H5::Exception &e) {
+        throw std::runtime_error(fmt::format("Could not open {}: {}", filename, e.getDetailMsg()));
+    }
+}
+
+void WriteStringAttribute(H5::H5Object &object, const std::string &name, const std::string &value) {
+    H5::StrType type(H5::PredType::C_S1, H5T_VARIABLE);
+    H5::Attribute attribute = object.createAttribute(name, type, H5::DataSpace(H5S_SCALAR));
+    attribute.write(type, value);
+}
+
+std::string ReadStringAttribute(const H5::H5Object &object, const std::string &name) {
+    std::string value;
+    if(!object.attrExists(name)) return value;
+    H5::Attribute attribute = object.openAttribute(name);
+    attribute.read(attribute.getStrType(), value);
+    return value;
+}
+
+}
+
+HDF5Writer::HDF5Writer(const std::string &filename, unsigned int compression, size_t chunk)
+        : m_file{OpenFile(filename, H5F_ACC_TRUNC)}, m_compression{compression}, m_chunk{chunk} {
+    if(m_compression > 9) {
+        throw std::runtime_error(fmt::format("HDF5Writer: Invalid compression level {}, "
+                                             "expected a value between 0 and 9", m_compression));
+    }
+    if(m_chunk == 0) m_chunk = chunk_default;
+
+    try {
+        H5::Group events = m_file.createGroup("events");
+        m_weight = CreateDataSet(events, "weight", H5::PredType::NATIVE_DOUBLE);
+        m_flux = CreateDataSet(events, "flux", H5::PredType::NATIVE_DOUBLE);
+        m_remnant = CreateDataSet(events, "remnant", H5::PredType::NATIVE_INT32);
+        m_offset = CreateDataSet(events, "offset", H5::PredType::NATIVE_UINT64);
+
+        H5::Group particles = m_file.createGroup("particles");
+        m_pid = CreateDataSet(particles, "pid", H5::PredType::NATIVE_INT32);
+        m_status = CreateDataSet(particles, "status", H5::PredType::NATIVE_INT32);
+        m_momentum = CreateDataSet(particles, "momentum", H5::PredType::NATIVE_DOUBLE, 4);
+    } catch(const H5::Exception &e) {
+        throw std::runtime_error(fmt::format("HDF5Writer: Could not create {}: {}",
+                                             filename, e.getDetailMsg()));
+    }
+}
+
+HDF5Writer::~HDF5Writer() {
+    try {
+        Flush();
+    } catch(const H5::Exception &e) {
+        spdlog::error("HDF5Writer: Failed to write events: {}", e.getDetailMsg());
+    }
+}
+
+H5::DataSet HDF5Writer::CreateDataSet(H5::Group &group, const std::string &name,
+                                      const H5::PredType &type, hsize_t ncols) {
+    const int rank = ncols > 1 ? 2 : 1;
+    std::array<hsize_t, 2> dims{0, ncols};
+    std::array<hsize_t, 2> max_dims{H5S_UNLIMITED, ncols};
+    H5::DataSpace space(rank, dims.data(), max_dims.data());
+
+    H5::DSetCreatPropList properties;
+    std::array<hsize_t, 2> chunk{m_chunk, ncols};
+    properties.setChunk(rank, chunk.data());
+    if(m_compression > 0) {
+        properties.setShuffle();
+        properties.setDeflate(static_cast<int>(m_compression));
+    }
+    return group.createDataSet(name, type, space, properties);
+}
+
+void HDF5Writer::WriteHeader(const std::string &filename) {
+    std::ifstream input(filename);
+    std::stringstream run_card;
+    run_card << input.rdbuf();
+    WriteStringAttribute(m_file, "version", ACHILLES_VERSION);
+    WriteStringAttribute(m_file, "run_card", run_card.str());
+}
+
+void HDF5Writer::Write(const Event &event) {
+    const auto policy = Policy(event);
+    if(policy == ZeroWeightPolicy::skip) return;
+
+    m_weights.push_back(event.Weight());
+    m_fluxes.push_back(event.Flux());
+    m_remnants.push_back(event.Remnant().PID());
+    m_offsets.push_back(m_nparticles);
+    // Compact events are stored without any particles
+    if(policy == ZeroWeightPolicy::compact) {
+        if(m_weights.size() >= m_chunk) Flush();
+        return;
+    }
+    for(const auto &particle : event.Particles()) {
+        m_pids.push_back(static_cast<int32_t>(particle.ID().AsInt()));
+        m_statuses.push_back(static_cast<int32_t>(particle.Status()));
+        for(size_t i = 0; i < 4; ++i) m_momenta.push_back(particle.Momentum()[i]);
+        ++m_nparticles;
+    }
+
+    if(m_weights.size() >= m_chunk) Flush();
+}
+
+void HDF5Writer::Flush() {
+    Append(m_weight, m_weights, H5::PredType::NATIVE_DOUBLE);
+    Append(m_flux, m_fluxes, H5::PredType::NATIVE_DOUBLE);
+    Append(m_remnant, m_remnants, H5::PredType::NATIVE_INT32);
+    Append(m_offset, m_offsets, H5::PredType::NATIVE_UINT64);
+    Append(m_pid, m_pids, H5::PredType::NATIVE_INT32);
+    Append(m_status, m_statuses, H5::PredType::NATIVE_INT32);
+    Append(m_momentum, m_momenta, H5::PredType::NATIVE_DOUBLE, 4);
+    m_file.flush(H5F_SCOPE_GLOBAL);
+
+    m_weights.clear();
+    m_fluxes.clear();
+    m_remnants.clear();
+    m_offsets.clear();
+    m_pids.clear();
+    m_statuses.clear();
+    m_momenta.clear();
+}
+
+HDF5Reader::HDF5Reader(const std::string &filename) : m_file{OpenFile(filename, H5F_ACC_RDONLY)} {
+    try {
+        m_version = ReadStringAttribute(m_file, "version");
+        m_run_card = ReadStringAttribute(m_file, "run_card");
+
+        H5::Group events = m_file.openGroup("events");
+        m_weights = ReadAll<double>(events.openDataSet("weight"), H5::PredType::NATIVE_DOUBLE);
+        m_fluxes = ReadAll<double>(events.openDataSet("flux"), H5::PredType::NATIVE_DOUBLE);
+        m_remnants = ReadAll<int32_t>(events.openDataSet("remnant"), H5::PredType::NATIVE_INT32);
+        m_offsets = ReadAll<uint64_t>(events.openDataSet("offset"), H5::PredType::NATIVE_UINT64);
+
+        H5::Group particles = m_file.openGroup("particles");
+        m_pid = particles.openDataSet("pid");
+        m_status = particles.openDataSet("status");
+        m_momentum = particles.openDataSet("momentum");
+        hsize_t nparticles{};
+        m_pid.getSpace().getSimpleExtentDims(&nparticles);
+        m_nparticles = nparticles;
+    } catch(const H5::Exception &e) {
+        throw std::runtime_error(fmt::format("HDF5Reader: Could not read {}: {}",
+                                             filename, e.getDetailMsg()));
+    }
+}
+
+std::vector<achilles::Particle> HDF5Reader::Particles(size_t event) const {
+    if(event >= NEvents()) {
+        throw std::out_of_range(fmt::format("HDF5Reader: Requested event {}, but file only has {} events",
+                                            event, NEvents()));
+    }
+
+    const hsize_t start = m_offsets[event];
+    const hsize_t end = event + 1 < NEvents() ? m_offsets[event + 1] : m_nparticles;
+    const hsize_t count = end - start;
+    std::vector<int32_t> pids(count), statuses(count);
+    std::vector<double> momenta(4*count);
+    if(count > 0) {
+        auto read = [&](const H5::DataSet &dataset, void *data, const H5::PredType &type, hsize_t ncols) {
+            const int rank = ncols > 1 ? 2 : 1;
+            H5::DataSpace file_space = dataset.getSpace();
+            std::array<hsize_t, 2> offset{start, 0};
+            std::array<hsize_t, 2> size{count, ncols};
+            file_space.selectHyperslab(H5S_SELECT_SET, size.data(), offset.data());
+            H5::DataSpace memory_space(rank, size.data());
+            dataset.read(data, type, memory_space, file_space);
+        };
+        read(m_pid, pids.data(), H5::PredType::NATIVE_INT32, 1);
+        read(m_status, statuses.data(), H5::PredType::NATIVE_INT32, 1);
+        read(m_momentum, momenta.data(), H5::PredType::NATIVE_DOUBLE, 4);
+    }
+
+    std::vector<Particle> result;
+    result.reserve(count);
+    for(size_t i = 0; i < count; ++i) {
+        FourVector momentum{momenta[4*i], momenta[4*i+1], momenta[4*i+2], momenta[4*i+3]};
+        result.emplace_back(PID{pids[i]}, momentum, ThreeVector{}, static_cast<ParticleStatus>(statuses[i]));
+    }
+    return result;
+}
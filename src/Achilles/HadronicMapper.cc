@@ -3,6 +3,7 @@
 #include "Achilles/FourVector.hh"
 #include "Achilles/ThreeVector.hh"
 #include "Achilles/ParticleInfo.hh"
+#include "Achilles/SpectralFunction.hh"
 #include "spdlog/spdlog.h"
 
 using achilles::QESpectralMapper;
@@ -21,7 +22,8 @@ void QESpectralMapper::GeneratePoint(std::vector<FourVector> &point, const std::
     // Generate inital nucleon state
     double dp = point[1].E() + sqrt(pow(point[1].E(), 2) + 2*point[1].E()*Constant::mN + Constant::mN2 - Smin());
     dp = dp > 800 ? 800 : dp;
-    const double mom = dp*rans[0];
+    const double pnorm = MomentumNorm(dp);
+    const double mom = pnorm > 0 ? m_sampler -> SampleMomentum(pnorm*rans[0]) : dp*rans[0];
     double cosT_max = (2*point[1].E()*Constant::mN+Constant::mN2-mom*mom-Smin())/(2*point[1].E()*mom);
     cosT_max = cosT_max > 1 ? 1 : cosT_max;
     const double cosT = (cosT_max + 1)*rans[1] - 1;
@@ -32,7 +34,8 @@ void QESpectralMapper::GeneratePoint(std::vector<FourVector> &point, const std::
     const double det = pow(point[1].E(), 2) + mom*mom + 2*pmom*point[1].Vec3() + Smin();
     double emax = Constant::mN + point[1].E() - sqrt(det);
     emax = emax > 400 ? 400 : emax;
-    const double energy = emax*rans[3] - 1e-8;
+    const double enorm = pnorm > 0 ? EnergyNorm(mom, emax) : 0;
+    const double energy = enorm > 0 ? m_sampler -> SampleEnergy(mom, enorm*rans[3]) : emax*rans[3] - 1e-8;
     // if(emax < 0) energy = emax - 1;
     // const double energy = dE*rans[3];
     
@@ -53,7 +56,9 @@ void QESpectralMapper::GeneratePoint(std::vector<FourVector> &point, const std::
 double QESpectralMapper::GenerateWeight(const std::vector<FourVector> &point, std::vector<double> &rans) {
     double dp = point[1].E() + sqrt(pow(point[1].E(), 2) + 2*point[1].E()*Constant::mN + Constant::mN2 - Smin());
     dp = dp > 800 ? 800 : dp;
-    rans[0] = point[HadronIdx()].P()/dp;
+    const double mom = point[HadronIdx()].P();
+    const double pnorm = MomentumNorm(dp);
+    rans[0] = pnorm > 0 ? m_sampler -> MomentumCDF(mom)/pnorm : mom/dp;
     double cosT_max = (2*point[1].E()*Constant::mN+Constant::mN2-point[0].P2()-Smin())/(2*point[1].E()*point[0].P());
     cosT_max = cosT_max > 1 ? 1 : cosT_max;
     double dCos = (cosT_max + 1);
@@ -66,8 +71,11 @@ double QESpectralMapper::GenerateWeight(const std::vector<FourVector> &point, st
     emax = emax > 400 ? 400 : emax;
     const double energy = Constant::mN - point[HadronIdx()].E();
     // if(energy < 0) return std::numeric_limits<double>::infinity();
-    const double dE = emax;
-    rans[3] = (energy + 1e-8)/emax;
+    const double enorm = pnorm > 0 ? EnergyNorm(mom, emax) : 0;
+    rans[3] = enorm > 0 ? m_sampler -> EnergyCDF(mom, energy)/enorm : (energy + 1e-8)/emax;
+    // Inverse of the density of the momentum and energy for the sampled case
+    const double dp_eff = pnorm > 0 ? pnorm/m_sampler -> MomentumDensity(mom) : dp;
+    const double dE = enorm > 0 ? enorm/m_sampler -> EnergyDensity(mom, energy) : emax;
     // rans[3] = (Constant::mN - point[HadronIdx()].E())/dE; 
 
     // double cosT_max = (point[HadronIdx()].M2() + 2*point[1].E()*point[HadronIdx()].E() - Smin())/(2*point[HadronIdx()].P()*point[1].P());
@@ -75,13 +83,23 @@ double QESpectralMapper::GenerateWeight(const std::vector<FourVector> &point, st
     // const double dCos = (cosT_max + 1);
     rans[1] = (point[HadronIdx()].CosTheta()+1)/dCos;
 
-    double wgt = 1.0/point[0].P2()/dp/dCos/dPhi/dE;
+    double wgt = 1.0/point[0].P2()/dp_eff/dCos/dPhi/dE;
     Mapper<FourVector>::Print(__PRETTY_FUNCTION__, point, rans);
     spdlog::trace("  Weight: {}", wgt);
-    spdlog::trace("  dp: {}", dp);
+    spdlog::trace("  dp: {}", dp_eff);
     spdlog::trace("  dCos: {}", dCos);
     spdlog::trace("  dPhi: {}", dPhi);
     spdlog::trace("  dE: {}", dE);
 
     return wgt;
 }
+
+double QESpectralMapper::MomentumNorm(double dp) const {
+    if(!m_sampler) return 0;
+    return m_sampler -> MomentumCDF(dp);
+}
+
+double QESpectralMapper::EnergyNorm(double mom, double emax) const {
+    if(!m_sampler) return 0;
+    return m_sampler -> EnergyCDF(mom, emax);
+}
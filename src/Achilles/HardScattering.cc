@@ -1,4 +1,5 @@
 #include <iostream>
+#include <set>
 #include <utility>
 
 #include "Achilles/HardScattering.hh"
@@ -47,6 +48,10 @@ void LeptonicCurrent::Initialize(const Process_Info &process) {
         }
     }
     anti = process.m_ids[0].AsInt() < 0;
+
+    const auto &dirac = DiracMatrices::Instance();
+    for(size_t mu = 0; mu < 4; ++mu)
+        m_vertex[mu] = SplitSpinMatrix(coupl_left*dirac.gamma[mu]*dirac.pl + coupl_right*dirac.gamma[mu]*dirac.pr);
 }
 
 bool LeptonicCurrent::NeutralCurrent(achilles::PID initial, achilles::PID final) const {
@@ -108,10 +113,8 @@ achilles::FFDictionary LeptonicCurrent::GetFormFactor() {
     return results;
 }
 
-achilles::Currents LeptonicCurrent::CalcCurrents(const std::vector<FourVector> &p,
-                                                 const double&) const {
-    Currents currents;
-
+void LeptonicCurrent::CalcCurrents(const std::vector<FourVector> &p,
+                                   const double&, CurrentTensor &currents) const {
     // Setup spinors
     FourVector pU, pUBar;
     if(anti) {
@@ -121,31 +124,21 @@ achilles::Currents LeptonicCurrent::CalcCurrents(const std::vector<FourVector> &
         pU = -p[1];
         pUBar = p.back();
     }
-    std::array<Spinor, 2> ubar, u;
-    ubar[0] = UBarSpinor(-1, pUBar);
-    ubar[1] = UBarSpinor(1, pUBar);
-    u[0] = USpinor(-1, pU);
-    u[1] = USpinor(1, pU);
+    const auto ubar = UBarSpinors(pUBar);
+    const auto u = USpinors(pU);
 
     // Calculate currents
-    Current result;
+    currents.Reset(4);
     double q2 = (p[1] - p.back()).M2();
     std::complex<double> prop = std::complex<double>(0, 1)/(q2-mass*mass-std::complex<double>(0, 1)*mass*width);
     spdlog::trace("Calculating Current for {}", pid);
-    for(size_t i = 0; i < 2; ++i) {
-        for(size_t j = 0; j < 2; ++j) {
-            std::vector<std::complex<double>> subcur(4);
-            for(size_t mu = 0; mu < 4; ++mu) {
-                subcur[mu] = ubar[i]*(coupl_left*SpinMatrix::GammaMu(mu)*SpinMatrix::PL()
-                                    + coupl_right*SpinMatrix::GammaMu(mu)*SpinMatrix::PR())*u[j]*prop;
-                spdlog::trace("Current[{}][{}] = {}", 2*i+j, mu, subcur[mu]);
-            }
-            result.push_back(subcur);
+    const auto current = Sandwich(ubar, m_vertex, u);
+    for(size_t hel = 0; hel < current.size(); ++hel) {
+        for(size_t mu = 0; mu < 4; ++mu) {
+            currents(0, hel, mu) = current[hel][mu]*prop;
+            spdlog::trace("Current[{}][{}] = {}", hel, mu, currents(0, hel, mu));
         }
     }
-    currents[pid] = result;
-
-    return currents;
 }
 
 void HardScattering::SetProcess(const Process_Info &process) {
@@ -153,10 +146,45 @@ void HardScattering::SetProcess(const Process_Info &process) {
     m_leptonicProcess = process;
     m_current.Initialize(process);
     SMFormFactor = m_current.GetFormFactor();
+    m_bosons.clear();
+    m_bosons.Add(m_current.Boson());
+    SetupFormFactors();
+}
+
+#ifdef ENABLE_BSM
+void HardScattering::SetSherpa(SherpaMEs *const _sherpa) {
+    p_sherpa = _sherpa;
+    if(!m_leptonicProcess.m_ids.empty()) SetupFormFactors();
 }
+#endif
 
-achilles::Currents HardScattering::LeptonicCurrents(const std::vector<FourVector> &p,
-                                                    const double &mu2) const {
+void HardScattering::SetupFormFactors() {
+    // TODO: Clean this up and make generic for the nuclear model
+    static const std::array<PID, 3> targets{PID::proton(), PID::neutron(), PID::carbon()};
+    m_ffInfo.assign(targets.size(), {});
+#ifdef ENABLE_BSM
+    // The form factors are set up once both the process and Sherpa are known
+    if(!p_sherpa) return;
+    std::set<int> bosons;
+    for(const auto &target : targets) {
+        for(const auto &boson : p_sherpa -> Bosons(target)) bosons.insert(boson);
+    }
+    for(const auto &boson : bosons) {
+        for(size_t i = 0; i < targets.size(); ++i)
+            m_ffInfo[i][boson] = p_sherpa -> FormFactors(targets[i], boson);
+    }
+#else
+    // TODO: Define values somewhere
+    for(size_t slot = 0; slot < m_bosons.size(); ++slot) {
+        const int boson = m_bosons.PID(slot);
+        for(size_t i = 0; i < targets.size(); ++i)
+            m_ffInfo[i][boson] = SMFormFactor.at({targets[i], boson});
+    }
+#endif
+}
+
+void HardScattering::LeptonicCurrents(const std::vector<FourVector> &p, const double &mu2,
+                                      BosonSlots &bosons, CurrentTensor &result) const {
 #ifdef ENABLE_BSM
     // TODO: Move adapter code into Sherpa interface code
     std::vector<std::array<double, 4>> mom(p.size());
@@ -169,66 +197,43 @@ achilles::Currents HardScattering::LeptonicCurrents(const std::vector<FourVector
     }
     auto currents = p_sherpa -> Calc(pids, mom, mu2);
 
-    for(auto &current : currents) { 
+    // The bosons are only known once Sherpa returns the currents
+    bosons.clear();
+    result.Reset(currents.begin() -> second.size());
+    const double norm = pow(1_GeV, static_cast<double>(mom.size())-3);
+    for(const auto &current : currents) { 
         spdlog::trace("Current for {}", current.first);
+        const size_t slot = bosons.Add(current.first);
         for(size_t i = 0; i < current.second.size(); ++i) {
             for(size_t j = 0; j < current.second[0].size(); ++j) {
-                current.second[i][j] /= pow(1_GeV, static_cast<double>(mom.size())-3);
-                spdlog::trace("Current[{}][{}] = {}", i, j, current.second[i][j]);
+                result(slot, i, j) = current.second[i][j]/norm;
+                spdlog::trace("Current[{}][{}] = {}", i, j, result(slot, i, j));
             }
         }
     }
-    return currents;
 #else
-    return m_current.CalcCurrents(p, mu2);
+    bosons = m_bosons;
+    m_current.CalcCurrents(p, mu2, result);
 #endif
 }
 
 std::vector<double> HardScattering::CrossSection(Event &event) const {
     // Calculate leptonic currents
-    auto leptonCurrent = LeptonicCurrents(event.Momentum(), 100);
+    BosonSlots bosons;
+    CurrentTensor leptonCurrent;
+    LeptonicCurrents(event.Momentum(), 100, bosons, leptonCurrent);
 
     // Calculate the hadronic currents
-    // TODO: Clean this up and make generic for the nuclear model
-    // TODO: Move this to initialization to remove check each time
-    static std::vector<NuclearModel::FFInfoMap> ffInfo;
-    if(ffInfo.empty()) {
-        ffInfo.resize(3);
-        for(const auto &current : leptonCurrent) {
-#ifdef ENABLE_BSM
-            ffInfo[0][current.first] = p_sherpa -> FormFactors(PID::proton(), current.first);
-            ffInfo[1][current.first] = p_sherpa -> FormFactors(PID::neutron(), current.first);
-            ffInfo[2][current.first] = p_sherpa -> FormFactors(PID::carbon(), current.first);
-#else
-            // TODO: Define values somewhere
-            ffInfo[0][current.first] = SMFormFactor.at({PID::proton(), current.first});
-            ffInfo[1][current.first] = SMFormFactor.at({PID::neutron(), current.first});
-            ffInfo[2][current.first] = SMFormFactor.at({PID::carbon(), current.first});
-#endif
-        }
-    }
-    auto hadronCurrent = m_nuclear -> CalcCurrents(event, ffInfo);
+    auto hadronCurrent = m_nuclear -> CalcCurrents(event, m_ffInfo);
 
-    std::vector<double> amps2(hadronCurrent.size());
-    const size_t nlep_spins = leptonCurrent.begin()->second.size();
+    // Each hadronic current is packed into the boson slots of the leptonic current once,
+    // such that the contraction only works on contiguous arrays
+    std::vector<double> xsecs(hadronCurrent.size());
     const size_t nhad_spins = m_nuclear -> NSpins();
-    for(size_t i = 0; i  < nlep_spins; ++i) {
-        for(size_t j = 0; j < nhad_spins; ++j) {
-            double sign = 1.0;
-            std::vector<std::complex<double>> amps(hadronCurrent.size());
-            for(size_t mu = 0; mu < 4; ++mu) {
-                for(const auto &lcurrent : leptonCurrent) {
-                    auto boson = lcurrent.first;
-                    for(size_t k = 0; k < hadronCurrent.size(); ++k) {
-                        if(hadronCurrent[k].find(boson) != hadronCurrent[k].end())
-                            amps[k] += sign*lcurrent.second[i][mu]*hadronCurrent[k][boson][j][mu];
-                    }
-                }
-                sign = -1.0;
-            }
-            for(size_t k = 0; k < hadronCurrent.size(); ++k)
-                amps2[k] += std::norm(amps[k]);
-        }
+    CurrentTensor current;
+    for(size_t k = 0; k < hadronCurrent.size(); ++k) {
+        current.Pack(bosons, hadronCurrent[k], nhad_spins);
+        xsecs[k] = ContractSquared(leptonCurrent, current);
     }
 
     double spin_avg = 1;
@@ -241,9 +246,8 @@ std::vector<double> HardScattering::CrossSection(Event &event) const {
     double mass = ParticleInfo(m_leptonicProcess.m_states.begin()->first[0]).Mass();
     double flux = 2*event.Momentum()[1].E()*2*sqrt(event.Momentum()[0].P2() + mass*mass);
     static constexpr double to_nb = 1e6;
-    std::vector<double> xsecs(hadronCurrent.size());
     for(size_t i = 0; i < hadronCurrent.size(); ++i) {
-        xsecs[i] = amps2[i]*Constant::HBARC2/spin_avg/flux*to_nb;
+        xsecs[i] *= Constant::HBARC2/spin_avg/flux*to_nb;
         spdlog::debug("Xsec[{}] = {}", i, xsecs[i]);
     }
 
@@ -1,16 +1,31 @@
 #include "Achilles/Histogram.hh"
 #include "fmt/format.h"
 
-#include <fstream>
-#include <stdexcept>
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
 #include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
 
 namespace achilles {
 
+namespace {
+
+uint64_t NextHistogramId() {
+    static std::atomic<uint64_t> next_id{1};
+    return next_id++;
+}
+
+}
+
+Histogram::Histogram() : m_id{NextHistogramId()} {}
+
 Histogram::Histogram(const size_t& nbins, const double& lower, const double& upper,
                      std::string name_, std::string path_) :
-                    name{std::move(name_)}, path{std::move(path_)} {
+                    name{std::move(name_)}, path{std::move(path_)}, m_id{NextHistogramId()} {
     binvals = std::vector<double>(nbins, 0);
     errors = std::vector<double>(nbins, 0);
     double binsize = (upper-lower)/static_cast<double>(nbins);
@@ -18,36 +33,203 @@ Histogram::Histogram(const size_t& nbins, const double& lower, const double& upp
     for(size_t i = 0; i <= nbins; ++i) {
         binedges[i] = lower+static_cast<double>(i)*binsize;
     }
+    CheckUniform();
 }
 
 Histogram::Histogram(std::vector<double> binedges_, std::string name_,
                      std::string path_) : 
-                    name{std::move(name_)}, path{std::move(path_)}, binedges{std::move(binedges_)} {
+                    name{std::move(name_)}, path{std::move(path_)}, binedges{std::move(binedges_)},
+                    m_id{NextHistogramId()} {
     binvals = std::vector<double>(binedges.size()-1, 0);
     errors = std::vector<double>(binedges.size()-1, 0);
     for(size_t i = 0; i < binvals.size(); ++i) {
         if(binedges[i]>binedges[i+1]) throw std::runtime_error("Bin edges must be in increasing order!");
         if(binedges[i]==binedges[i+1]) throw std::runtime_error("Bin edges must not be identical!");
     }
+    CheckUniform();
+}
+
+// Copies only contain the merged bin values, the shards belong to the original
+Histogram::Histogram(const Histogram &other)
+    : name{other.name}, path{other.path}, binedges{other.binedges},
+      uniform{other.uniform}, inv_width{other.inv_width}, m_id{NextHistogramId()} {
+    auto merged = other.Snapshot();
+    binvals = std::move(merged.binvals);
+    errors = std::move(merged.errors);
+    nentries = merged.nentries;
+}
+
+// The id moves with the shards, such that threads filling the histogram keep using them
+Histogram::Histogram(Histogram &&other) noexcept
+    : name{std::move(other.name)}, path{std::move(other.path)}, binedges{std::move(other.binedges)},
+      binvals{std::move(other.binvals)}, errors{std::move(other.errors)}, nentries{other.nentries},
+      uniform{other.uniform}, inv_width{other.inv_width}, m_id{other.m_id},
+      m_shards{std::move(other.m_shards)} {
+    other.m_id = NextHistogramId();
+    other.m_shards.clear();
+}
+
+Histogram& Histogram::operator=(const Histogram &other) {
+    if(this != &other) *this = Histogram(other);
+    return *this;
+}
+
+Histogram& Histogram::operator=(Histogram &&other) noexcept {
+    if(this == &other) return *this;
+    name = std::move(other.name);
+    path = std::move(other.path);
+    binedges = std::move(other.binedges);
+    binvals = std::move(other.binvals);
+    errors = std::move(other.errors);
+    nentries = other.nentries;
+    uniform = other.uniform;
+    inv_width = other.inv_width;
+    // The old id is never reused, so no thread can find the discarded shards
+    m_id = other.m_id;
+    m_shards = std::move(other.m_shards);
+    other.m_id = NextHistogramId();
+    other.m_shards.clear();
+    return *this;
+}
+
+void Histogram::CheckUniform() {
+    if(binedges.size() < 2) return;
+    const double width = (binedges.back() - binedges.front())/static_cast<double>(binedges.size()-1);
+    static constexpr double tolerance = 1e-10;
+    uniform = true;
+    for(size_t i = 0; i + 1 < binedges.size(); ++i) {
+        if(std::abs(binedges[i+1] - binedges[i] - width) > tolerance*width) {
+            uniform = false;
+            return;
+        }
+    }
+    inv_width = 1.0/width;
 }
 
 size_t Histogram::FindBin(const double& x) const {
+    if(uniform) {
+        // Same convention as the binary search below, values on an edge belong to the lower bin
+        if(!(x > binedges.front())) return 0;
+        if(x > binedges.back()) return static_cast<size_t>(-1);
+        auto loc = static_cast<size_t>(std::ceil((x - binedges.front())*inv_width));
+        loc = std::min(std::max(loc, size_t{1}), binedges.size()-1);
+        // Correct for rounding, such that the result agrees with the bin edges exactly
+        if(x <= binedges[loc-1]) --loc;
+        else if(x > binedges[loc]) ++loc;
+        return loc;
+    }
+
     auto it = std::lower_bound(binedges.begin(),binedges.end(), x);
     if(it == binedges.end()) return static_cast<size_t>(-1);
 
     return static_cast<size_t>(std::distance(binedges.begin(),it));
 }
 
-void Histogram::Fill(const double& x, const double& wgt) {
+struct Histogram::LocalShards {
+    // The raw pointer is used while filling, and the weak pointer to find the
+    // shards of destroyed histograms
+    struct Entry {
+        Shard *shard;
+        std::weak_ptr<Shard> owner;
+    };
+    static constexpr size_t min_prune = 16;
+
+    std::unordered_map<uint64_t, Entry> shards;
+    size_t next_prune{min_prune};
+};
+
+Histogram::LocalShards& Histogram::ThreadShards() {
+    thread_local LocalShards local;
+    return local;
+}
+
+size_t Histogram::NLocalShards() {
+    return ThreadShards().shards.size();
+}
+
+Histogram::Shard& Histogram::LocalShard() {
+    // Each thread keeps the shards it fills by histogram id. Ids are never reused, so
+    // entries of destroyed histograms are never looked up again
+    auto &local = ThreadShards();
+    auto it = local.shards.find(m_id);
+    if(it != local.shards.end()) return *(it -> second.shard);
+
+    // Remove the entries of destroyed histograms whenever the map has doubled in size,
+    // such that it stays proportional to the number of live histograms
+    if(local.shards.size() >= local.next_prune) {
+        for(auto entry = local.shards.begin(); entry != local.shards.end();) {
+            if(entry -> second.owner.expired()) entry = local.shards.erase(entry);
+            else ++entry;
+        }
+        local.next_prune = std::max(LocalShards::min_prune, 2*local.shards.size());
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Not allocated with make_shared, such that the weak pointers do not keep the bins alive
+    m_shards.push_back(std::shared_ptr<Shard>(new Shard(binvals.size())));
+    local.shards.emplace(m_id, LocalShards::Entry{m_shards.back().get(), m_shards.back()});
+    return *m_shards.back();
+}
+
+size_t Histogram::NShards() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_shards.size();
+}
+
+void Histogram::Accumulate(Shard &shard, double x, double wgt) const {
     const size_t loc = FindBin(x);
-    nentries++;
+    shard.nentries++;
     if(loc != static_cast<size_t>(-1) && loc != 0) {
-        binvals[loc-1] += wgt/(binedges[loc]-binedges[loc-1]);
-        errors[loc-1] += pow(wgt/(binedges[loc]-binedges[loc-1]), 2);
+        const double value = wgt/(binedges[loc]-binedges[loc-1]);
+        shard.binvals[loc-1] += value;
+        shard.errors[loc-1] += value*value;
+    }
+}
+
+Histogram::Shard Histogram::Snapshot() const {
+    Shard result(0);
+    result.binvals = binvals;
+    result.errors = errors;
+    result.nentries = nentries;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for(const auto &shard : m_shards) {
+        for(size_t i = 0; i < binvals.size(); ++i) {
+            result.binvals[i] += shard -> binvals[i];
+            result.errors[i] += shard -> errors[i];
+        }
+        result.nentries += shard -> nentries;
     }
+    return result;
+}
+
+void Histogram::Fill(const double& x, const double& wgt) {
+    Accumulate(LocalShard(), x, wgt);
+}
+
+void Histogram::Fill(const std::vector<double>& x, const std::vector<double>& wgt) {
+    if(x.size() != wgt.size())
+        throw std::runtime_error(fmt::format("Histogram: Got {} values but {} weights", x.size(), wgt.size()));
+    auto &shard = LocalShard();
+    for(size_t i = 0; i < x.size(); ++i) Accumulate(shard, x[i], wgt[i]);
+}
+
+void Histogram::Merge() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for(auto &shard : m_shards) {
+        for(size_t i = 0; i < binvals.size(); ++i) {
+            binvals[i] += std::exchange(shard -> binvals[i], 0);
+            errors[i] += std::exchange(shard -> errors[i], 0);
+        }
+        nentries += std::exchange(shard -> nentries, 0);
+    }
+}
+
+size_t Histogram::Entries() const {
+    return Snapshot().nentries;
 }
 
 void Histogram::Scale(const double& scale) {
+    Merge();
     for(double & binval : binvals) {
         binval *= scale;
     }
@@ -72,8 +254,12 @@ double Histogram::Integral(size_t lower, size_t upper) const {
     if(upper > binvals.size())
         throw std::runtime_error("Invalid range for histogram integration");
 
+    // The upper limit is inclusive, and an upper limit of the number of bins is the overflow
+    const auto values = Snapshot().binvals;
+    if(values.empty()) return 0;
+    upper = std::min(upper, values.size()-1);
     for(size_t i = lower; i <= upper; ++i) {
-        const auto mean = binvals[i];
+        const auto mean = values[i];
         result += mean*(binedges[i+1]-binedges[i]);
     }
 
@@ -81,12 +267,13 @@ double Histogram::Integral(size_t lower, size_t upper) const {
 }
 
 void Histogram::Save(std::ostream *out) const {
+    const auto merged = Snapshot();
     *out << name << std::endl;
     *out << fmt::format("{:^15} {:^15} {:^15} {:^15}\n",
                        "lower edge", "upper edge", "value", "error");
     for(size_t i = 0; i < binvals.size(); ++i) {
         *out << fmt::format("{:< 15.6e} {:< 15.6e} {:< 15.6e} {:< 15.6e}\n",
-                           binedges[i], binedges[i+1], binvals[i], std::sqrt(errors[i]));
+                           binedges[i], binedges[i+1], merged.binvals[i], std::sqrt(merged.errors[i]));
     }
 }
 
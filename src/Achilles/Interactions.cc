@@ -9,6 +9,7 @@
 #include "Achilles/FourVector.hh"
 #include "Achilles/Interactions.hh"
 #include "Achilles/Particle.hh"
+#include "Achilles/TableCache.hh"
 #include "Achilles/ThreeVector.hh"
 #include "Achilles/Utilities.hh"
 #include "Achilles/Random.hh"
@@ -287,30 +288,39 @@ GeantInteractionsDt::GeantInteractionsDt(const YAML::Node& node) {
 }
 
 void GeantInteractionsDt::LoadData(bool samePID, const std::string &filename) {
-    std::ifstream data(filename);
-
-    // Read in CDFs
     const size_t nlines = samePID ? 40 : 39;
-    auto cdf = ReadBlock(data, nlines);
-
-    // Read in tmin and tmax
-    auto tmin = ReadBlock(data, 2);
-    auto tmax = ReadBlock(data, 1);
-
-    // Read in pcm
-    auto ecm2 = ReadBlock(data, 2);
+    const std::string kind = samePID ? "GeantDtPP" : "GeantDtNP";
+    auto table = TableCache::Load(filename, kind, [&](const std::string &name) {
+        std::ifstream data(name);
+        Table result;
+
+        // Read in CDFs
+        result.columns.push_back(ReadBlock(data, nlines));
+
+        // Read in tmin and tmax
+        result.columns.push_back(ReadBlock(data, 2));
+        result.columns.push_back(ReadBlock(data, 1));
+
+        // Read in pcm
+        result.columns.push_back(ReadBlock(data, 2));
+
+        // Read in lab energy and max sigma
+        result.columns.push_back(ReadBlock(data, 2));
+        result.columns.push_back(ReadBlock(data, 2));
+
+        // Read in total cross-section
+        result.columns.push_back(ReadBlock(data, 2));
+
+        data.close();
+        return result;
+    });
+    const auto &cdf = table.columns[0];
+    const auto &tmin = table.columns[1];
+    auto &ecm2 = table.columns[3];
+    const auto &xsec = table.columns[6];
     for(auto & e : ecm2)
         e = 4*(e*e + Constant::mN*Constant::mN);
 
-    // Read in lab energy and max sigma
-    auto elab = ReadBlock(data, 2);
-    auto max_sig = ReadBlock(data, 2);
-
-    // Read in total cross-section
-    auto xsec = ReadBlock(data, 2);
-
-    data.close();
-
     // Obtain the PDF from the CDF
     const size_t npts = cdf.size()/tmin.size();
     std::vector<double> pdf(ecm2.size()*npts);
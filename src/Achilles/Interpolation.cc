@@ -255,3 +255,78 @@ double Interp2D::PolynomialInterp(double x, double y) const {
     }
     return Polint(xInterp, tmp2, polyOrderX, x);
 }
+
+bool RegularGridInterp2D::IsRegular(const std::vector<double> &x, double tol) {
+    if(x.size() < 2) return false;
+    const double step = (x.back() - x.front())/static_cast<double>(x.size() - 1);
+    if(step <= 0) return false;
+    for(size_t i = 1; i < x.size(); ++i) {
+        if(std::abs(x[i] - x[i-1] - step) > tol*step) return false;
+    }
+    return true;
+}
+
+RegularGridInterp2D::RegularGridInterp2D(const std::vector<double>& x, const std::vector<double>& y,
+                                         const std::vector<double>& z)
+        : m_nx{x.size()}, m_ny{y.size()} {
+    if(m_nx < 4 || m_ny < 2)
+        throw std::runtime_error("Regular grid interpolation requires at least 4 x-values and 2 y-values.");
+    if(!IsRegular(x) || !IsRegular(y))
+        throw std::runtime_error("Inputs must be equally spaced.");
+    if(x.size()*y.size() != z.size())
+        throw std::runtime_error("Input and output arrays must be the same size.");
+
+    m_xmin = x.front();
+    m_xmax = x.back();
+    m_ymin = y.front();
+    m_ymax = y.back();
+    m_invhx = static_cast<double>(m_nx - 1)/(m_xmax - m_xmin);
+    m_invhy = static_cast<double>(m_ny - 1)/(m_ymax - m_ymin);
+
+    // Expand the cubic through the stencil in powers of the distance (in units of the step)
+    // from the first point of the stencil, using Newton forward differences
+    m_coeffs.resize((m_nx - 1)*m_ny*4);
+    for(size_t i = 0; i < m_nx - 1; ++i) {
+        const size_t start = std::min(i > 0 ? i - 1 : 0, m_nx - 4);
+        for(size_t j = 0; j < m_ny; ++j) {
+            const double f0 = z[start*m_ny + j];
+            const double f1 = z[(start + 1)*m_ny + j];
+            const double f2 = z[(start + 2)*m_ny + j];
+            const double f3 = z[(start + 3)*m_ny + j];
+            const double d1 = f1 - f0;
+            const double d2 = f2 - 2*f1 + f0;
+            const double d3 = f3 - 3*f2 + 3*f1 - f0;
+            double *coeffs = &m_coeffs[(i*m_ny + j)*4];
+            coeffs[0] = f0;
+            coeffs[1] = d1 - d2/2 + d3/3;
+            coeffs[2] = (d2 - d3)/2;
+            coeffs[3] = d3/6;
+        }
+    }
+}
+
+double RegularGridInterp2D::operator()(double x, double y) const {
+    // Disallow extrapolation
+    if(x > m_xmax) 
+        throw std::domain_error(fmt::format("Input ({}) greater than maximum x value ({})", x, m_xmax));
+    if(x < m_xmin) 
+        throw std::domain_error(fmt::format("Input ({}) less than minimum x value ({})", x, m_xmin));
+    if(y > m_ymax) 
+        throw std::domain_error(fmt::format("Input ({}) greater than maximum y value ({})", y, m_ymax));
+    if(y < m_ymin) 
+        throw std::domain_error(fmt::format("Input ({}) less than minimum y value ({})", y, m_ymin));
+
+    const double tx = (x - m_xmin)*m_invhx;
+    const double ty = (y - m_ymin)*m_invhy;
+    const size_t i = std::min(static_cast<size_t>(tx), m_nx - 2);
+    const size_t j = std::min(static_cast<size_t>(ty), m_ny - 2);
+    const size_t start = std::min(i > 0 ? i - 1 : 0, m_nx - 4);
+    const double u = tx - static_cast<double>(start);
+    const double v = ty - static_cast<double>(j);
+
+    const double *c0 = &m_coeffs[(i*m_ny + j)*4];
+    const double *c1 = c0 + 4;
+    const double z0 = ((c0[3]*u + c0[2])*u + c0[1])*u + c0[0];
+    const double z1 = ((c1[3]*u + c1[2])*u + c1[1])*u + c1[0];
+    return z0 + v*(z1 - z0);
+}
@@ -52,6 +52,36 @@ void achilles::MultiChannel::MaxDifference(const std::vector<double> &train) {
     }
 }
 
+void achilles::MultiChannel::SaveState(std::ostream &out) const {
+    io::WriteSize(out, ndims);
+    io::WriteBinary(out, params);
+    io::WriteBinary(out, channel_weights);
+    io::WriteBinary(out, best_weights);
+    io::WriteBinary(out, min_diff);
+    summary.SaveState(out);
+}
+
+bool achilles::MultiChannel::LoadState(std::istream &in) {
+    uint64_t dims{};
+    MultiChannelParams tmp_params;
+    std::vector<double> tmp_weights, tmp_best;
+    double tmp_diff{};
+    MultiChannelSummary tmp_summary;
+    if(!io::ReadBinary(in, dims) || !io::ReadBinary(in, tmp_params)
+       || !io::ReadBinary(in, tmp_weights) || !io::ReadBinary(in, tmp_best)
+       || !io::ReadBinary(in, tmp_diff) || !tmp_summary.LoadState(in)) return false;
+
+    // Ensure the checkpoint matches the layout of this integrator
+    if(dims != ndims || tmp_weights.size() != channel_weights.size()) return false;
+
+    params = tmp_params;
+    channel_weights = std::move(tmp_weights);
+    best_weights = std::move(tmp_best);
+    min_diff = tmp_diff;
+    summary = std::move(tmp_summary);
+    return true;
+}
+
 achilles::MultiChannelSummary achilles::MultiChannel::Summary() {
     summary.best_weights = best_weights;
     std::cout << "Final integral = "
@@ -1,8 +1,9 @@
 #include "Achilles/NuclearModel.hh"
 #include "Achilles/PhaseSpaceBuilder.hh"
+#include "Achilles/HadronicMapper.hh"
 #include "Achilles/FourVector.hh"
 #include "Achilles/Nucleus.hh"
-#include "Achilles/Spinor.hh"
+#include "Achilles/DiracAlgebra.hh"
 #include "Achilles/Particle.hh"
 
 using achilles::NuclearModel;
@@ -114,15 +115,15 @@ bool Coherent::FillNucleus(Event &event, const std::vector<double> &xsecs) const
     event.SetMEWeight(xsecs[0]);
 
     // Remove all nucleons
-    event.CurrentNucleus() -> Nucleons().clear();
+    event.Hadrons().clear();
 
     // Setup initial and final state nucleus
     Particle initial = Particle(nucleus_pid, event.Momentum().front());
     initial.Status() = ParticleStatus::initial_state;
-    event.CurrentNucleus() -> Nucleons().push_back(initial);
+    event.Hadrons().push_back(initial);
     Particle final(nucleus_pid, event.Momentum()[2]);
     final.Status() = ParticleStatus::final_state;
-    event.CurrentNucleus() -> Nucleons().push_back(final);
+    event.Hadrons().push_back(final);
 
     return true;
 }
@@ -139,6 +140,15 @@ QESpectral::QESpectral(const YAML::Node &config, const YAML::Node &form_factor,
           spectral_proton{config["NuclearModel"]["SpectralP"].as<std::string>()},
           spectral_neutron{config["NuclearModel"]["SpectralN"].as<std::string>()} {
     b_ward = config["NuclearModel"]["Ward"].as<bool>();
+
+    // Optionally add a channel sampling the initial nucleon from the spectral functions
+    const auto sampling = config["NuclearModel"]["SpectralSampling"];
+    if(sampling && sampling.as<bool>()) {
+        const double floor = config["NuclearModel"]["SpectralFloor"]
+            ? config["NuclearModel"]["SpectralFloor"].as<double>() : 1e-3;
+        m_sampler = std::make_shared<const SpectralSampler>(
+                std::vector<const SpectralFunction*>{&spectral_proton, &spectral_neutron}, floor);
+    }
 }
 
 std::vector<NuclearModel::Currents> QESpectral::CalcCurrents(const Event &event,
@@ -165,11 +175,10 @@ std::vector<NuclearModel::Currents> QESpectral::CalcCurrents(const Event &event,
                   removal_energy, pIn.P(), spectral[1]);
     // Setup spinors
     pIn.E() = free_energy;
-    std::array<Spinor, 2> ubar, u;
-    ubar[0] = UBarSpinor(-1, pOut);
-    ubar[1] = UBarSpinor(1, pOut);
-    u[0] = USpinor(-1, -pIn);
-    u[1] = USpinor(1, -pIn);
+    const auto ubar = UBarSpinors(pOut);
+    const auto u = USpinors(-pIn);
+    // The bilinears only depend on the kinematics, and are shared by all form factors
+    const NucleonBilinears bilinears(ubar, u, qVec);
 
     // Loop over proton and neutron
     for(size_t i = 0; i < results.size(); ++i) {
@@ -177,7 +186,7 @@ std::vector<NuclearModel::Currents> QESpectral::CalcCurrents(const Event &event,
         for(const auto &formFactor : ff[i]) {
             auto ffVal = CouplingsFF(ffVals, formFactor.second);
             spdlog::debug("{}: f1 = {}, f2 = {}, fa = {}", i, ffVal[0], ffVal[1], ffVal[2]);
-            auto current = HadronicCurrent(ubar, u, qVec, ffVal);
+            auto current = HadronicCurrent(bilinears, ffVal);
             for(auto &subcur : current) {
                 for(auto &val : subcur) {
                     // TODO: Move this to phase space 
@@ -218,14 +227,12 @@ void QESpectral::AllowedStates(Process_Info &info) const {
 }
 
 bool QESpectral::FillNucleus(Event &event, const std::vector<double> &xsecs) const {
-    // Calculate total cross section
-    for(size_t i = 0; i < event.CurrentNucleus() -> Nucleons().size(); ++i) {
-        auto current_nucleon = event.CurrentNucleus() -> Nucleons()[i];
-        if(current_nucleon.ID() == PID::proton()) {
-            event.MatrixElementWgt(i) = xsecs[0];
-        } else {
-            event.MatrixElementWgt(i) = xsecs[1];
-        }
+    // Calculate total cross section. The weights are ordered as protons then neutrons,
+    // such that the nucleon configuration is not needed to obtain the weight
+    const size_t nprotons = event.CurrentNucleus() -> NProtons();
+    auto &wgts = event.MatrixElementWgts();
+    for(size_t i = 0; i < wgts.size(); ++i) {
+        wgts[i] = i < nprotons ? xsecs[0] : xsecs[1];
     }
     if(!event.TotalCrossSection())
         return false;
@@ -233,35 +240,20 @@ bool QESpectral::FillNucleus(Event &event, const std::vector<double> &xsecs) con
     return true;
 }
 
+std::vector<std::shared_ptr<achilles::HadronicBeamMapper>> QESpectral::HadronicChannels(size_t idx) const {
+    if(!m_sampler) return {};
+    return {std::make_shared<QESpectralMapper>(idx, m_sampler)};
+}
+
 std::unique_ptr<NuclearModel> QESpectral::Construct(const YAML::Node &config) {
     auto form_factor = LoadFormFactor(config);
     return std::make_unique<QESpectral>(config, form_factor);
 }
 
-NuclearModel::Current QESpectral::HadronicCurrent(const std::array<Spinor, 2> &ubar,
-                                                  const std::array<Spinor, 2> &u,
-                                                  const FourVector &qVec,
+NuclearModel::Current QESpectral::HadronicCurrent(const NucleonBilinears &bilinears,
                                                   const FormFactorArray &ffVal) const {
+    const auto current = bilinears(ffVal[0], ffVal[1], ffVal[2], Constant::mN);
     Current result;
-    std::array<SpinMatrix, 4> gamma{};
-    for(size_t mu = 0; mu < 4; ++mu) {
-        gamma[mu] = ffVal[0]*SpinMatrix::GammaMu(mu) + ffVal[2]*SpinMatrix::GammaMu(mu)*SpinMatrix::Gamma_5();
-        double sign = 1;
-        for(size_t nu = 0; nu < 4; ++nu) {
-            gamma[mu] += std::complex<double>(0, 1)*(ffVal[1]*SpinMatrix::SigmaMuNu(mu, nu)*sign*qVec[nu]/(2*Constant::mN));
-            sign = -1;
-        }
-    }
-
-    for(size_t i = 0; i < 2; ++i) {
-        for(size_t j = 0; j < 2; ++j) {
-            std::vector<std::complex<double>> subcur(4);
-            for(size_t mu = 0; mu < 4; ++mu) {
-                subcur[mu] = ubar[i]*gamma[mu]*u[j];
-            }
-            result.push_back(subcur);
-        }
-    }
-
+    for(const auto &subcur : current) result.emplace_back(subcur.begin(), subcur.end());
     return result;
 }
@@ -12,6 +12,7 @@
 #include "Achilles/ThreeVector.hh"
 #include "Achilles/Particle.hh"
 #include "Achilles/Nucleus.hh"
+#include "Achilles/TableCache.hh"
 #include "Achilles/Utilities.hh"
 
 using namespace achilles;
@@ -43,30 +44,39 @@ Nucleus::Nucleus(const std::size_t& Z, const std::size_t& A, const double& bEner
     }
     
     nucleons.resize(A);
-    protons.resize(Z);
-    neutrons.resize(A-Z);
+    nprotons = Z;
+    nneutrons = A-Z;
     // TODO: Refactor elsewhere in the code, maybe make dynamic?
     // spdlog::info("Nucleus: inferring nuclear radius using 0.16 nucleons/fm^3.");
     // constexpr double nucDensity = 0.16;
     // radius = std::cbrt(static_cast<double>(A) / (4 / 3 * M_PI * nucDensity));
 
-    std::ifstream densityFile(densityFilename);
-    if(!densityFile.is_open())
-        throw std::runtime_error(fmt::format("Nucleus: Density file {} does not exist.", densityFilename));
-    std::string lineContent;
-   
-    constexpr size_t HeaderLength = 16;
-    for(size_t i = 0; i < HeaderLength; ++i) {       
-        std::getline(densityFile, lineContent);
-    }
+    auto table = TableCache::Load(densityFilename, "Density", [](const std::string &filename) {
+        std::ifstream densityFile(filename);
+        if(!densityFile.is_open())
+            throw std::runtime_error(fmt::format("Nucleus: Density file {} does not exist.", filename));
+        std::string lineContent;
+
+        constexpr size_t HeaderLength = 16;
+        for(size_t i = 0; i < HeaderLength; ++i) {       
+            std::getline(densityFile, lineContent);
+        }
+
+        double radius_{}, density_{}, densityErr{};
+        Table result;
+        result.columns.resize(2);
+        while(densityFile >> radius_ >> density_ >> densityErr) {
+            result.columns[0].push_back(radius_);
+            result.columns[1].push_back(density_);
+        }
+        return result;
+    });
+    auto &vecRadius = table.columns[0];
+    auto &vecDensity = table.columns[1];
 
-    double radius_{}, density_{}, densityErr{};
-    std::vector<double> vecRadius, vecDensity;
     constexpr double minDensity = 1E-6;
-    while(densityFile >> radius_ >> density_ >> densityErr) {
-        if(density_ < minDensity && radius == 0) radius=radius_;
-        vecRadius.push_back(std::move(radius_));
-        vecDensity.push_back(std::move(density_));
+    for(size_t i = 0; i < vecRadius.size(); ++i) {
+        if(vecDensity[i] < minDensity && radius == 0) radius = vecRadius[i];
     }
 
     rhoInterp.SetData(vecRadius, vecDensity);
@@ -112,24 +122,16 @@ Nucleus::Nucleus(const std::size_t& Z, const std::size_t& A, const double& bEner
 
 void Nucleus::SetNucleons(Particles& _nucleons) noexcept {
     nucleons = _nucleons;
-    std::size_t idx = 0;
-    std::size_t proton_idx = 0;
-    std::size_t neutron_idx = 0;
-    for(auto particle : nucleons) {
-        if(particle.ID() == PID::proton()) {
-            if(proton_idx >= protons.size()) {
-                protons.push_back(particle);
-                proton_idx++;
-            } else protons[proton_idx++] = particle;
-            protonLoc.push_back(idx++);
-        }
-        else if(particle.ID() == PID::neutron()) {
-            if(neutron_idx >= neutrons.size()) {
-                neutrons.push_back(particle);
-                neutron_idx++;
-            } else neutrons[neutron_idx++] = particle;
-            neutronLoc.push_back(idx++);
-        }
+    UpdateLocations();
+}
+
+void Nucleus::UpdateLocations() noexcept {
+    // The locations are rebuilt in place, so the memory used stays bounded over many events
+    protonLoc.clear();
+    neutronLoc.clear();
+    for(std::size_t idx = 0; idx < nucleons.size(); ++idx) {
+        if(nucleons[idx].ID() == PID::proton()) protonLoc.push_back(idx);
+        else if(nucleons[idx].ID() == PID::neutron()) neutronLoc.push_back(idx);
     }
 }
 
@@ -149,7 +151,8 @@ void Nucleus::GenerateConfig() {
     }
 
     // Update the nucleons in the nucleus
-    SetNucleons(particles);
+    nucleons = std::move(particles);
+    UpdateLocations();
 }
 
 const std::array<double, 3> Nucleus::GenerateMomentum(const double &position) noexcept {
@@ -18,8 +18,16 @@ void NucleusModule(py::module &m) {
         .def("set_radius", &achilles::Nucleus::SetRadius)
         // Getters
         .def("nucleons", &achilles::Nucleus::Nucleons)
-        .def("protons", &achilles::Nucleus::Protons)
-        .def("neutrons", &achilles::Nucleus::Neutrons)
+        .def("protons", [](const achilles::Nucleus &nuc) {
+            achilles::Particles result;
+            for(const auto &idx : nuc.ProtonsIDs()) result.push_back(nuc.Nucleons()[idx]);
+            return result;
+        })
+        .def("neutrons", [](const achilles::Nucleus &nuc) {
+            achilles::Particles result;
+            for(const auto &idx : nuc.NeutronsIDs()) result.push_back(nuc.Nucleons()[idx]);
+            return result;
+        })
         .def("n_nucleons", &achilles::Nucleus::NNucleons)
         .def("n_protons", &achilles::Nucleus::NProtons)
         .def("n_neutrons", &achilles::Nucleus::NNeutrons)
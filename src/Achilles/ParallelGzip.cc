@@ -0,0 +1,144 @@
+#include "Achilles/ParallelGzip.hh"
+#include "Achilles/Logging.hh"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+using achilles::ParallelGzipBuf;
+
+ParallelGzipBuf::ParallelGzipBuf(const std::string &filename, int level, size_t threads, size_t block)
+        : m_file{filename, std::ios::binary}, m_level{level}, m_buffer(block > 0 ? block : block_default) {
+    if(m_level < 0 || m_level > 9) {
+        throw std::runtime_error(fmt::format("ParallelGzip: Invalid compression level {}, "
+                                             "expected a value between 0 and 9", m_level));
+    }
+    if(threads == 0) threads = std::max(std::thread::hardware_concurrency(), 1u);
+    m_open = static_cast<bool>(m_file);
+    if(!m_open) return;
+
+    // Keep a few blocks per thread in flight, such that the workers never run dry
+    // while bounding the memory usage
+    m_max_blocks = 2*threads;
+    setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+    for(size_t i = 0; i < threads; ++i)
+        m_workers.emplace_back(&ParallelGzipBuf::Run, this);
+}
+
+ParallelGzipBuf::~ParallelGzipBuf() {
+    try {
+        Close();
+    } catch(const std::exception &e) {
+        spdlog::error("ParallelGzip: {}", e.what());
+    }
+}
+
+void ParallelGzipBuf::Close() {
+    if(!m_open) return;
+    m_open = false;
+    const bool success = Submit() && WriteReady(true);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_work.notify_all();
+    for(auto &worker : m_workers) worker.join();
+    m_workers.clear();
+    m_file.close();
+    if(!success) throw std::runtime_error("ParallelGzip: Failed to compress the output");
+}
+
+ParallelGzipBuf::int_type ParallelGzipBuf::overflow(int_type ch) {
+    if(!m_open || !Submit()) return traits_type::eof();
+    if(traits_type::eq_int_type(ch, traits_type::eof())) return traits_type::not_eof(ch);
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+}
+
+int ParallelGzipBuf::sync() {
+    return m_open && WriteReady(false) ? 0 : -1;
+}
+
+bool ParallelGzipBuf::Submit() {
+    const auto size = static_cast<size_t>(pptr() - pbase());
+    if(size > 0) {
+        auto block = std::make_shared<Block>();
+        block -> input.assign(pbase(), pptr());
+        block -> size = size;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending.push_back(block);
+            m_order.push_back(block);
+        }
+        m_work.notify_one();
+        setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+    }
+    return WriteReady(false);
+}
+
+bool ParallelGzipBuf::WriteReady(bool all) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while(!m_order.empty()) {
+        auto block = m_order.front();
+        if(!block -> done) {
+            // Only wait if too many blocks are in flight (back-pressure) or when closing
+            if(!all && m_order.size() <= m_max_blocks) break;
+            m_done.wait(lock, [&]() { return block -> done; });
+        }
+        m_order.pop_front();
+        if(block -> failed) return false;
+
+        lock.unlock();
+        m_frames.push_back(m_position);
+        m_file.write(block -> output.data(), static_cast<std::streamsize>(block -> output.size()));
+        m_position.compressed += block -> output.size();
+        m_position.uncompressed += block -> size;
+        lock.lock();
+        if(!m_file) return false;
+    }
+    return true;
+}
+
+void ParallelGzipBuf::Compress(Block &block) const {
+    z_stream stream{};
+    // Window bits of 15 + 16 produce a gzip header and trailer
+    static constexpr int window_bits = 15 + 16, memory_level = 8;
+    if(deflateInit2(&stream, m_level, Z_DEFLATED, window_bits, memory_level, Z_DEFAULT_STRATEGY) != Z_OK) {
+        block.failed = true;
+        return;
+    }
+
+    block.output.resize(deflateBound(&stream, block.input.size()));
+    stream.next_in = reinterpret_cast<Bytef*>(block.input.data());
+    stream.avail_in = static_cast<uInt>(block.input.size());
+    stream.next_out = reinterpret_cast<Bytef*>(block.output.data());
+    stream.avail_out = static_cast<uInt>(block.output.size());
+    block.failed = deflate(&stream, Z_FINISH) != Z_STREAM_END;
+    block.output.resize(stream.total_out);
+    block.input.clear();
+    block.input.shrink_to_fit();
+    deflateEnd(&stream);
+}
+
+void ParallelGzipBuf::Run() {
+    for(;;) {
+        std::shared_ptr<Block> block;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_work.wait(lock, [&]() { return m_stop || !m_pending.empty(); });
+            if(m_pending.empty()) return;
+            block = m_pending.front();
+            m_pending.pop_front();
+        }
+
+        Compress(*block);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            block -> done = true;
+        }
+        m_done.notify_all();
+    }
+}
@@ -11,8 +11,9 @@
 
 using achilles::PSBuilder;
 
-PSBuilder& PSBuilder::Beam(std::shared_ptr<achilles::Beam> beam, const std::vector<double> &masses, size_t idx) {
-    phase_space->lbeam = std::make_shared<BeamMapper>(idx, beam); 
+PSBuilder& PSBuilder::Beam(std::shared_ptr<achilles::Beam> beam, const std::vector<double> &masses, size_t idx,
+                           PID pid) {
+    phase_space->lbeam = std::make_shared<BeamMapper>(idx, beam, pid);
     phase_space->lbeam->SetMasses(masses);
     return *this;
 }
@@ -23,6 +24,12 @@ PSBuilder& PSBuilder::Hadron(const std::string &mode, const std::vector<double>
     return *this;
 }
 
+PSBuilder& PSBuilder::HadronMapper(std::shared_ptr<HadronicBeamMapper> mapper, const std::vector<double> &masses) {
+    phase_space->hbeam = std::move(mapper);
+    phase_space->hbeam->SetMasses(masses);
+    return *this;
+}
+
 PSBuilder& PSBuilder::FinalState(const std::string &channel, const std::vector<double> &masses2) {
     phase_space->main = PSFactory<FinalStateMapper, std::vector<double>>::Build(channel, masses2);
     return *this;
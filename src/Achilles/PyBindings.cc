@@ -13,6 +13,7 @@ PYBIND11_MODULE(_achilles, m) {
     ParticleInfoModule(physics);
     ParticleModule(physics);
     NucleusModule(physics);
+    EventReaderModule(physics);
 
     // Calculation Objects
     InteractionsModule(m);
@@ -1,25 +1,42 @@
 #include "Achilles/SpectralFunction.hh"
+#include "Achilles/TableCache.hh"
 #include "spdlog/spdlog.h"
+#include "fmt/format.h"
+#include <algorithm>
 #include <fstream>
 #include <cmath>
+#include <stdexcept>
 
 using achilles::SpectralFunction;
+using achilles::SpectralSampler;
 
 SpectralFunction::SpectralFunction(const std::string &filename) {
-    std::ifstream data(filename);
-    size_t ne{}, np{};
-    data >> ne >> np;
-    mom.resize(np);
-    energy.resize(ne);
-    spectral.resize(ne*np);
-    std::vector<double> dp_p(np);
-    for(size_t j = 0; j < np; ++j) {
-        data >> mom[j];
-        for(size_t i = 0; i < ne; ++i) {
-            data >> energy[i] >> spectral[j*ne+i];
+    auto table = TableCache::Load(filename, "SpectralFunction", [](const std::string &name) {
+        std::ifstream data(name);
+        if(!data.is_open())
+            throw std::runtime_error(fmt::format("SpectralFunction: File {} does not exist", name));
+        size_t ne{}, np{};
+        data >> ne >> np;
+        Table result;
+        result.header = {static_cast<int64_t>(ne), static_cast<int64_t>(np)};
+        result.columns.resize(3);
+        auto &p = result.columns[0], &e = result.columns[1], &s = result.columns[2];
+        p.resize(np);
+        e.resize(ne);
+        s.resize(ne*np);
+        for(size_t j = 0; j < np; ++j) {
+            data >> p[j];
+            for(size_t i = 0; i < ne; ++i) {
+                data >> e[i] >> s[j*ne+i];
+            }
         }
-    }
-    data.close();
+        return result;
+    });
+    mom = std::move(table.columns[0]);
+    energy = std::move(table.columns[1]);
+    spectral = std::move(table.columns[2]);
+    const size_t np = mom.size(), ne = energy.size();
+    std::vector<double> dp_p(np);
 
     double hp = mom[1] - mom[0];
     double he = energy[1] - energy[0];
@@ -46,14 +63,139 @@ SpectralFunction::SpectralFunction(const std::string &filename) {
     overestimate.SetPolyOrder(1);
 
     // Setup spectral function interpolator
-    func = Interp2D(mom, energy, spectral, InterpolationType::Polynomial);
-    func.SetPolyOrder(3, 1);
+    regular = RegularGridInterp2D::IsRegular(mom) && RegularGridInterp2D::IsRegular(energy);
+    if(regular) {
+        grid = RegularGridInterp2D(mom, energy, spectral);
+    } else {
+        spdlog::warn("Spectral function {} is not on a regular grid, using general interpolation", filename);
+        func = Interp2D(mom, energy, spectral, InterpolationType::Polynomial);
+        func.SetPolyOrder(3, 1);
+    }
 }
 
 double SpectralFunction::operator()(double p, double E) const {
     if(p < mom.front() || p > mom.back() || E < energy.front() || E > energy.back())
         return 0;
 
-    auto result = func(p, E);
+    auto result = regular ? grid(p, E) : func(p, E);
     return result > 0 ? result : 0;
 }
+
+SpectralSampler::SpectralSampler(const std::vector<const SpectralFunction*> &funcs, double floor) {
+    if(funcs.empty())
+        throw std::runtime_error("SpectralSampler: Requires at least one spectral function");
+    if(floor < 0 || floor > 1)
+        throw std::runtime_error(fmt::format("SpectralSampler: Uniform fraction must be in [0, 1], got {}", floor));
+    m_mom = funcs.front() -> Momentum();
+    m_energy = funcs.front() -> Energy();
+    for(const auto *func : funcs) {
+        if(func -> Momentum() != m_mom || func -> Energy() != m_energy)
+            throw std::runtime_error("SpectralSampler: Spectral functions must be tabulated on the same grid");
+    }
+    const size_t np = m_mom.size(), ne = m_energy.size();
+    if(np < 2 || ne < 2)
+        throw std::runtime_error("SpectralSampler: Requires at least two momentum and energy values");
+
+    // Phase space weighted spectral function at the knots
+    std::vector<double> knots(np*ne);
+    for(size_t i = 0; i < np; ++i) {
+        for(size_t j = 0; j < ne; ++j) {
+            for(const auto *func : funcs)
+                knots[i*ne+j] += std::max((*func)(m_mom[i], m_energy[j]), 0.0);
+            knots[i*ne+j] *= m_mom[i]*m_mom[i];
+        }
+    }
+
+    // Weight of each cell from the average of the corners
+    std::vector<double> cells((np-1)*(ne-1));
+    double total{}, area{};
+    for(size_t i = 0; i < np-1; ++i) {
+        for(size_t j = 0; j < ne-1; ++j) {
+            const double size = (m_mom[i+1] - m_mom[i])*(m_energy[j+1] - m_energy[j]);
+            cells[i*(ne-1)+j] = size*(knots[i*ne+j] + knots[i*ne+j+1]
+                                      + knots[(i+1)*ne+j] + knots[(i+1)*ne+j+1])/4;
+            total += cells[i*(ne-1)+j];
+            area += size;
+        }
+    }
+    if(total <= 0 && floor < 1)
+        throw std::runtime_error("SpectralSampler: Spectral functions vanish everywhere");
+
+    // Mix with the uniform distribution and build the CDFs
+    m_pprob.assign(np-1, 0);
+    m_pcdf.assign(np, 0);
+    m_eprob.assign((np-1)*(ne-1), 0);
+    m_ecdf.assign((np-1)*ne, 0);
+    for(size_t i = 0; i < np-1; ++i) {
+        for(size_t j = 0; j < ne-1; ++j) {
+            const double size = (m_mom[i+1] - m_mom[i])*(m_energy[j+1] - m_energy[j]);
+            double &prob = m_eprob[i*(ne-1)+j];
+            prob = floor*size/area;
+            if(total > 0) prob += (1 - floor)*cells[i*(ne-1)+j]/total;
+            m_pprob[i] += prob;
+        }
+        m_pcdf[i+1] = m_pcdf[i] + m_pprob[i];
+        for(size_t j = 0; j < ne-1; ++j) {
+            if(m_pprob[i] > 0) m_eprob[i*(ne-1)+j] /= m_pprob[i];
+            m_ecdf[i*ne+j+1] = m_ecdf[i*ne+j] + m_eprob[i*(ne-1)+j];
+        }
+        m_ecdf[i*ne+ne-1] = 1;
+    }
+    m_pcdf.back() = 1;
+}
+
+size_t SpectralSampler::MomentumCell(double p) const {
+    const auto idx = static_cast<size_t>(std::distance(m_mom.begin(), std::upper_bound(m_mom.begin(), m_mom.end(), p)));
+    return std::min(idx > 0 ? idx - 1 : 0, m_mom.size() - 2);
+}
+
+size_t SpectralSampler::EnergyCell(double E) const {
+    const auto idx = static_cast<size_t>(std::distance(m_energy.begin(), std::upper_bound(m_energy.begin(), m_energy.end(), E)));
+    return std::min(idx > 0 ? idx - 1 : 0, m_energy.size() - 2);
+}
+
+double SpectralSampler::MomentumCDF(double p) const {
+    if(p <= m_mom.front()) return 0;
+    if(p >= m_mom.back()) return 1;
+    const size_t i = MomentumCell(p);
+    return m_pcdf[i] + m_pprob[i]*(p - m_mom[i])/(m_mom[i+1] - m_mom[i]);
+}
+
+double SpectralSampler::MomentumDensity(double p) const {
+    if(p < m_mom.front() || p > m_mom.back()) return 0;
+    const size_t i = MomentumCell(p);
+    return m_pprob[i]/(m_mom[i+1] - m_mom[i]);
+}
+
+double SpectralSampler::SampleMomentum(double ran) const {
+    const auto idx = static_cast<size_t>(std::distance(m_pcdf.begin(), std::upper_bound(m_pcdf.begin(), m_pcdf.end(), ran)));
+    const size_t i = std::min(idx > 0 ? idx - 1 : 0, m_mom.size() - 2);
+    if(m_pprob[i] <= 0) return m_mom[i];
+    return m_mom[i] + (ran - m_pcdf[i])/m_pprob[i]*(m_mom[i+1] - m_mom[i]);
+}
+
+double SpectralSampler::EnergyCDF(double p, double E) const {
+    if(E <= m_energy.front()) return 0;
+    if(E >= m_energy.back()) return 1;
+    const size_t ne = m_energy.size();
+    const size_t i = MomentumCell(p), j = EnergyCell(E);
+    return m_ecdf[i*ne+j] + m_eprob[i*(ne-1)+j]*(E - m_energy[j])/(m_energy[j+1] - m_energy[j]);
+}
+
+double SpectralSampler::EnergyDensity(double p, double E) const {
+    if(E < m_energy.front() || E > m_energy.back()) return 0;
+    const size_t ne = m_energy.size();
+    const size_t i = MomentumCell(p), j = EnergyCell(E);
+    return m_eprob[i*(ne-1)+j]/(m_energy[j+1] - m_energy[j]);
+}
+
+double SpectralSampler::SampleEnergy(double p, double ran) const {
+    const size_t ne = m_energy.size();
+    const size_t i = MomentumCell(p);
+    const auto begin = m_ecdf.begin() + static_cast<std::ptrdiff_t>(i*ne);
+    const auto idx = static_cast<size_t>(std::distance(begin, std::upper_bound(begin, begin + static_cast<std::ptrdiff_t>(ne), ran)));
+    const size_t j = std::min(idx > 0 ? idx - 1 : 0, ne - 2);
+    const double prob = m_eprob[i*(ne-1)+j];
+    if(prob <= 0) return m_energy[j];
+    return m_energy[j] + (ran - m_ecdf[i*ne+j])/prob*(m_energy[j+1] - m_energy[j]);
+}
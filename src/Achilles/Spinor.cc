@@ -1,8 +1,16 @@
 #include "Achilles/Spinor.hh"
 #include "Achilles/Utilities.hh"
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define ACHILLES_X86_SIMD
+#include <immintrin.h>
+#endif
+
 using achilles::Spinor;
 using achilles::SpinMatrix;
+using achilles::SplitSpinor;
+using achilles::SplitSpinMatrix;
+using achilles::SimdLevel;
 
 Spinor::Spinor(bool type, bool bar, const int &hel, const FourVector &mom, int ms)
         : m_type{type}, m_bar{bar}, m_hel{hel} {
@@ -111,3 +119,146 @@ Spinor achilles::operator*(const SpinMatrix &lhs, const Spinor &rhs) {
 
     return s;
 }
+
+namespace {
+
+SplitSpinor MultiplyScalar(const SplitSpinMatrix &mat, const SplitSpinor &u) {
+    SplitSpinor result;
+    for(size_t col = 0; col < 4; ++col) {
+        for(size_t row = 0; row < 4; ++row) {
+            const double re = mat.re[4*col + row], im = mat.im[4*col + row];
+            result.re[row] += re*u.re[col] - im*u.im[col];
+            result.im[row] += re*u.im[col] + im*u.re[col];
+        }
+    }
+    return result;
+}
+
+std::complex<double> DotScalar(const SplitSpinor &ubar, const SplitSpinor &u) {
+    double re = 0, im = 0;
+    for(size_t i = 0; i < 4; ++i) {
+        re += ubar.re[i]*u.re[i] - ubar.im[i]*u.im[i];
+        im += ubar.re[i]*u.im[i] + ubar.im[i]*u.re[i];
+    }
+    return {re, im};
+}
+
+#ifdef ACHILLES_X86_SIMD
+__attribute__((target("sse2")))
+SplitSpinor MultiplySSE2(const SplitSpinMatrix &mat, const SplitSpinor &u) {
+    SplitSpinor result;
+    // Rows 0-1 and 2-3 are handled in separate registers
+    for(size_t half = 0; half < 4; half += 2) {
+        __m128d re = _mm_setzero_pd(), im = _mm_setzero_pd();
+        for(size_t col = 0; col < 4; ++col) {
+            const __m128d cre = _mm_load_pd(&mat.re[4*col + half]);
+            const __m128d cim = _mm_load_pd(&mat.im[4*col + half]);
+            const __m128d ure = _mm_set1_pd(u.re[col]), uim = _mm_set1_pd(u.im[col]);
+            re = _mm_add_pd(re, _mm_sub_pd(_mm_mul_pd(cre, ure), _mm_mul_pd(cim, uim)));
+            im = _mm_add_pd(im, _mm_add_pd(_mm_mul_pd(cre, uim), _mm_mul_pd(cim, ure)));
+        }
+        _mm_store_pd(&result.re[half], re);
+        _mm_store_pd(&result.im[half], im);
+    }
+    return result;
+}
+
+__attribute__((target("sse2")))
+std::complex<double> DotSSE2(const SplitSpinor &ubar, const SplitSpinor &u) {
+    __m128d re = _mm_setzero_pd(), im = _mm_setzero_pd();
+    for(size_t half = 0; half < 4; half += 2) {
+        const __m128d are = _mm_load_pd(&ubar.re[half]), aim = _mm_load_pd(&ubar.im[half]);
+        const __m128d bre = _mm_load_pd(&u.re[half]), bim = _mm_load_pd(&u.im[half]);
+        re = _mm_add_pd(re, _mm_sub_pd(_mm_mul_pd(are, bre), _mm_mul_pd(aim, bim)));
+        im = _mm_add_pd(im, _mm_add_pd(_mm_mul_pd(are, bim), _mm_mul_pd(aim, bre)));
+    }
+    alignas(16) std::array<double, 2> sre{}, sim{};
+    _mm_store_pd(sre.data(), re);
+    _mm_store_pd(sim.data(), im);
+    return {sre[0] + sre[1], sim[0] + sim[1]};
+}
+
+__attribute__((target("avx2,fma")))
+SplitSpinor MultiplyAVX2(const SplitSpinMatrix &mat, const SplitSpinor &u) {
+    __m256d re = _mm256_setzero_pd(), im = _mm256_setzero_pd();
+    for(size_t col = 0; col < 4; ++col) {
+        const __m256d cre = _mm256_load_pd(&mat.re[4*col]);
+        const __m256d cim = _mm256_load_pd(&mat.im[4*col]);
+        const __m256d ure = _mm256_set1_pd(u.re[col]), uim = _mm256_set1_pd(u.im[col]);
+        re = _mm256_fnmadd_pd(cim, uim, _mm256_fmadd_pd(cre, ure, re));
+        im = _mm256_fmadd_pd(cim, ure, _mm256_fmadd_pd(cre, uim, im));
+    }
+    SplitSpinor result;
+    _mm256_store_pd(result.re.data(), re);
+    _mm256_store_pd(result.im.data(), im);
+    return result;
+}
+
+__attribute__((target("avx2,fma")))
+std::complex<double> DotAVX2(const SplitSpinor &ubar, const SplitSpinor &u) {
+    const __m256d are = _mm256_load_pd(ubar.re.data()), aim = _mm256_load_pd(ubar.im.data());
+    const __m256d bre = _mm256_load_pd(u.re.data()), bim = _mm256_load_pd(u.im.data());
+    const __m256d re = _mm256_fnmadd_pd(aim, bim, _mm256_mul_pd(are, bre));
+    const __m256d im = _mm256_fmadd_pd(aim, bre, _mm256_mul_pd(are, bim));
+    // Horizontal sums of both registers at once
+    const __m256d sum = _mm256_hadd_pd(re, im);
+    const __m128d total = _mm_add_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1));
+    alignas(16) std::array<double, 2> out{};
+    _mm_store_pd(out.data(), total);
+    return {out[0], out[1]};
+}
+#endif
+
+struct SpinorKernels {
+    SimdLevel level;
+    SplitSpinor (*multiply)(const SplitSpinMatrix&, const SplitSpinor&);
+    std::complex<double> (*dot)(const SplitSpinor&, const SplitSpinor&);
+};
+
+SpinorKernels Kernels(SimdLevel level) {
+    switch(level) {
+#ifdef ACHILLES_X86_SIMD
+        case SimdLevel::avx2:
+            return {level, MultiplyAVX2, DotAVX2};
+        case SimdLevel::sse2:
+            return {level, MultiplySSE2, DotSSE2};
+#endif
+        default:
+            return {SimdLevel::scalar, MultiplyScalar, DotScalar};
+    }
+}
+
+SpinorKernels &ActiveKernels() {
+    static SpinorKernels kernels = Kernels(achilles::DetectSimd());
+    return kernels;
+}
+
+}
+
+SimdLevel achilles::DetectSimd() {
+#ifdef ACHILLES_X86_SIMD
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SimdLevel::avx2;
+    if(__builtin_cpu_supports("sse2")) return SimdLevel::sse2;
+#endif
+    return SimdLevel::scalar;
+}
+
+SimdLevel achilles::ActiveSimd() {
+    return ActiveKernels().level;
+}
+
+SimdLevel achilles::UseSimd(SimdLevel level) {
+    const auto supported = DetectSimd();
+    if(static_cast<int>(level) > static_cast<int>(supported)) level = supported;
+    ActiveKernels() = Kernels(level);
+    return level;
+}
+
+SplitSpinor achilles::Multiply(const SplitSpinMatrix &mat, const SplitSpinor &u) {
+    return ActiveKernels().multiply(mat, u);
+}
+
+std::complex<double> achilles::Dot(const SplitSpinor &ubar, const SplitSpinor &u) {
+    return ActiveKernels().dot(ubar, u);
+}
@@ -0,0 +1,124 @@
+#include <stdexcept>
+
+#include "Achilles/Statistics.hh"
+#include "fmt/format.h"
+
+using achilles::Percentile;
+
+Percentile::Percentile(double percentile, double compression)
+        : m_percentile{percentile}, m_compression{compression} {
+    if(percentile < 0 || percentile > 1)
+        throw std::runtime_error(fmt::format("Percentile: Invalid percentile {}", percentile));
+    if(compression < 1)
+        throw std::runtime_error(fmt::format("Percentile: Invalid compression {}", compression));
+    m_centroids.reserve(static_cast<size_t>(2*m_compression));
+    m_buffer.reserve(static_cast<size_t>(5*m_compression));
+}
+
+void Percentile::Add(double x, double weight) {
+    if(weight <= 0) return;
+    m_buffer.push_back({x, weight});
+    m_unmerged += weight;
+    m_min = std::min(m_min, x);
+    m_max = std::max(m_max, x);
+    if(m_buffer.size() >= static_cast<size_t>(5*m_compression)) Compress();
+}
+
+void Percentile::Merge(const Percentile &other) {
+    other.Compress();
+    for(const auto &centroid : other.m_centroids) {
+        m_buffer.push_back(centroid);
+        m_unmerged += centroid.weight;
+        if(m_buffer.size() >= static_cast<size_t>(5*m_compression)) Compress();
+    }
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+}
+
+void Percentile::SaveState(std::ostream &out) const {
+    Compress();
+    io::WriteBinary(out, m_min);
+    io::WriteBinary(out, m_max);
+    io::WriteBinary(out, m_total);
+    io::WriteBinary(out, m_centroids);
+}
+
+bool Percentile::LoadState(std::istream &in) {
+    double tmp_min{}, tmp_max{}, tmp_total{};
+    std::vector<Centroid> tmp_centroids;
+    if(!io::ReadBinary(in, tmp_min) || !io::ReadBinary(in, tmp_max)
+       || !io::ReadBinary(in, tmp_total) || !io::ReadBinary(in, tmp_centroids)) return false;
+
+    m_min = tmp_min;
+    m_max = tmp_max;
+    m_total = tmp_total;
+    m_unmerged = 0;
+    m_centroids = std::move(tmp_centroids);
+    m_buffer.clear();
+    return true;
+}
+
+// Scale function k_2 from the t-digest paper, which gives the finest resolution
+// in the tails of the distribution
+double Percentile::ScaleFunction(double q, double normalizer) const {
+    static constexpr double eps = 1e-15;
+    q = std::clamp(q, eps, 1 - eps);
+    return normalizer * std::log(q / (1 - q));
+}
+
+void Percentile::Compress() const {
+    if(m_buffer.empty()) return;
+
+    m_buffer.insert(m_buffer.end(), m_centroids.begin(), m_centroids.end());
+    std::sort(m_buffer.begin(), m_buffer.end());
+    m_total += m_unmerged;
+    m_unmerged = 0;
+
+    const double normalizer = m_compression
+                            / (4*std::log(std::max(m_total / m_compression, 1.0)) + 24);
+    m_centroids.clear();
+    auto current = m_buffer.front();
+    double weight_so_far = 0;
+    double k_left = ScaleFunction(0, normalizer);
+    for(auto it = m_buffer.begin() + 1; it != m_buffer.end(); ++it) {
+        const double q_right = (weight_so_far + current.weight + it->weight) / m_total;
+        if(ScaleFunction(q_right, normalizer) - k_left <= 1) {
+            current.weight += it->weight;
+            current.mean += (it->mean - current.mean) * it->weight / current.weight;
+        } else {
+            m_centroids.push_back(current);
+            weight_so_far += current.weight;
+            k_left = ScaleFunction(weight_so_far / m_total, normalizer);
+            current = *it;
+        }
+    }
+    m_centroids.push_back(current);
+    m_buffer.clear();
+}
+
+double Percentile::Quantile(double q) const {
+    Compress();
+    if(m_centroids.empty()) return 0;
+    if(m_centroids.size() == 1) return m_centroids.front().mean;
+
+    // Each centroid is located at the center of its cumulative weight, and the
+    // quantile is linearly interpolated between neighboring centroids
+    const double index = q * m_total;
+    double center = m_centroids.front().weight / 2;
+    if(index <= center) {
+        return m_min + (m_centroids.front().mean - m_min) * index / center;
+    }
+
+    for(size_t i = 0; i + 1 < m_centroids.size(); ++i) {
+        const double next = center + (m_centroids[i].weight + m_centroids[i+1].weight) / 2;
+        if(index <= next) {
+            const double frac = (index - center) / (next - center);
+            return m_centroids[i].mean + frac * (m_centroids[i+1].mean - m_centroids[i].mean);
+        }
+        center = next;
+    }
+
+    const double remaining = m_total - center;
+    const double frac = std::min((index - center) / remaining, 1.0);
+    return m_centroids.back().mean + frac * (m_max - m_centroids.back().mean);
+}
@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "Achilles/Serialization.hh"
+#include "Achilles/Stratification.hh"
+
+using achilles::Stratification;
+
+namespace {
+
+size_t StrataForCalls(size_t dims, size_t ncalls, size_t max_hypercubes) {
+    // Use on average 4 points per hypercube, with at least 2 points per hypercube
+    // needed to estimate the variance
+    static constexpr double min_calls = 4;
+    const auto ndims = static_cast<double>(std::max<size_t>(dims, 1));
+    auto nstrat = static_cast<size_t>(std::floor(std::pow(static_cast<double>(ncalls)/min_calls, 1.0/ndims)));
+    nstrat = std::max<size_t>(nstrat, 1);
+    while(nstrat > 1 && std::pow(static_cast<double>(nstrat), ndims) > static_cast<double>(max_hypercubes))
+        --nstrat;
+    return nstrat;
+}
+
+size_t HypercubesForStrata(size_t dims, size_t nstrat) {
+    size_t nhcubes = 1;
+    for(size_t i = 0; i < dims; ++i) nhcubes *= nstrat;
+    return nhcubes;
+}
+
+}
+
+Stratification::Stratification(size_t dims, size_t ncalls, double beta, size_t max_hypercubes)
+        : m_dims{dims}, m_nstrat{StrataForCalls(dims, ncalls, max_hypercubes)}, m_beta{beta} {
+    const size_t nhcubes = HypercubesForStrata(m_dims, m_nstrat);
+    m_probs.assign(nhcubes, 1.0/static_cast<double>(nhcubes));
+    m_cumulative.resize(nhcubes);
+    UpdateCumulative();
+    Reset();
+}
+
+void Stratification::Resize(size_t ncalls, size_t max_hypercubes) {
+    const size_t nstrat = StrataForCalls(m_dims, ncalls, max_hypercubes);
+    if(nstrat == m_nstrat || m_dims == 0) return;
+
+    // Each new hypercube takes the sampling density of the old hypercube containing
+    // its center, such that the allocation learned so far is not lost
+    const size_t nhcubes = HypercubesForStrata(m_dims, nstrat);
+    std::vector<double> probs(nhcubes), center(m_dims);
+    double total = 0;
+    for(size_t i = 0; i < nhcubes; ++i) {
+        size_t hypercube = i;
+        for(size_t j = m_dims; j-- > 0;) {
+            center[j] = (static_cast<double>(hypercube % nstrat) + 0.5) / static_cast<double>(nstrat);
+            hypercube /= nstrat;
+        }
+        probs[i] = m_probs[FindHypercube(center)];
+        total += probs[i];
+    }
+    for(auto &prob : probs) prob /= total;
+
+    m_nstrat = nstrat;
+    m_probs = std::move(probs);
+    m_cumulative.resize(m_probs.size());
+    UpdateCumulative();
+    Reset();
+}
+
+std::vector<size_t> Stratification::Allocate(size_t ncalls) const {
+    static constexpr size_t min_calls = 2;
+    std::vector<size_t> calls(m_probs.size());
+    // Round the cumulative allocation, such that the total matches the requested calls
+    size_t previous = 0;
+    for(size_t i = 0; i < m_probs.size(); ++i) {
+        const auto current = static_cast<size_t>(std::lround(m_cumulative[i] * static_cast<double>(ncalls)));
+        calls[i] = std::max(current - previous, min_calls);
+        previous = current;
+    }
+    return calls;
+}
+
+size_t Stratification::Select(double ran) const {
+    auto it = std::upper_bound(m_cumulative.begin(), m_cumulative.end(), ran);
+    if(it == m_cumulative.end()) --it;
+    return static_cast<size_t>(std::distance(m_cumulative.begin(), it));
+}
+
+void Stratification::Map(size_t hypercube, std::vector<double> &rans) const {
+    if(m_nstrat == 1) return;
+    for(size_t i = m_dims; i-- > 0;) {
+        const auto idx = hypercube % m_nstrat;
+        hypercube /= m_nstrat;
+        rans[i] = (static_cast<double>(idx) + rans[i]) / static_cast<double>(m_nstrat);
+    }
+}
+
+size_t Stratification::FindHypercube(const std::vector<double> &y) const {
+    size_t hypercube = 0;
+    if(m_nstrat == 1) return hypercube;
+    for(size_t i = 0; i < m_dims; ++i)
+        hypercube = hypercube * m_nstrat + Stratum(y[i]);
+    return hypercube;
+}
+
+void Stratification::Adapt(bool central) {
+    if(m_probs.size() == 1) {
+        Reset();
+        return;
+    }
+
+    // Estimate the spread of the integrand in each hypercube. Hypercubes without
+    // enough samples are assigned the average of the others
+    std::vector<double> spread(m_probs.size(), -1);
+    double total = 0, nvalid = 0;
+    for(size_t i = 0; i < m_probs.size(); ++i) {
+        if(m_count[i] < (central ? 2 : 1)) continue;
+        const double mean = m_sum[i] / m_count[i];
+        double var = m_sum2[i] / m_count[i];
+        if(central) var = std::max(var - mean * mean, 0.0);
+        spread[i] = std::pow(std::sqrt(var), m_beta);
+        total += spread[i];
+        nvalid += 1;
+    }
+    Reset();
+    if(total == 0) return;
+
+    const double average = total / nvalid;
+    for(auto &d : spread) {
+        if(d < 0) d = average;
+    }
+    total += average * (static_cast<double>(m_probs.size()) - nvalid);
+
+    // Mix with a uniform allocation, such that no region is ever sampled with
+    // vanishing probability
+    static constexpr double uniform_fraction = 0.05;
+    const double uniform = 1.0 / static_cast<double>(m_probs.size());
+    for(size_t i = 0; i < m_probs.size(); ++i)
+        m_probs[i] = (1 - uniform_fraction) * spread[i] / total + uniform_fraction * uniform;
+    UpdateCumulative();
+}
+
+void Stratification::SaveState(std::ostream &out) const {
+    io::WriteSize(out, m_dims);
+    io::WriteSize(out, m_nstrat);
+    io::WriteBinary(out, m_beta);
+    io::WriteBinary(out, m_probs);
+}
+
+bool Stratification::LoadState(std::istream &in) {
+    uint64_t dims{}, nstrat{};
+    double beta{};
+    std::vector<double> probs;
+    if(!io::ReadBinary(in, dims) || !io::ReadBinary(in, nstrat)
+       || !io::ReadBinary(in, beta) || !io::ReadBinary(in, probs)) return false;
+    if(nstrat == 0) return false;
+    if(probs.size() != HypercubesForStrata(dims, nstrat)) return false;
+
+    m_dims = dims;
+    m_nstrat = nstrat;
+    m_beta = beta;
+    m_probs = std::move(probs);
+    m_cumulative.resize(m_probs.size());
+    UpdateCumulative();
+    Reset();
+    return true;
+}
+
+void Stratification::Reset() {
+    m_sum.assign(m_probs.size(), 0);
+    m_sum2.assign(m_probs.size(), 0);
+    m_count.assign(m_probs.size(), 0);
+}
+
+void Stratification::UpdateCumulative() {
+    std::partial_sum(m_probs.begin(), m_probs.end(), m_cumulative.begin());
+    const double norm = m_cumulative.back();
+    for(auto &c : m_cumulative) c /= norm;
+}
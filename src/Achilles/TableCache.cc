@@ -0,0 +1,144 @@
+#include "Achilles/TableCache.hh"
+#include "Achilles/Serialization.hh"
+
+#include "fmt/format.h"
+#include "spdlog/spdlog.h"
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include <unistd.h>
+
+using achilles::Table;
+using achilles::TableCache;
+
+namespace {
+
+constexpr std::array<char, 8> table_magic{'A', 'C', 'H', 'T', 'B', 'L', '\0', '\0'};
+
+// Hash of the raw bytes of the source file, or false if it can not be read
+bool SourceHash(const std::string &filename, uint64_t &hash) {
+    std::ifstream in(filename, std::ios::binary);
+    if(!in) return false;
+    const std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    hash = achilles::io::Hash(data);
+    return true;
+}
+
+}
+
+TableCache::CacheSettings& TableCache::Settings() {
+    static CacheSettings settings = []() {
+        CacheSettings result;
+        if(const char *env = std::getenv("ACHILLES_TABLE_CACHE")) {
+            const std::string value = env;
+            if(value == "off") result.enabled = false;
+            else result.directory = value;
+        }
+        return result;
+    }();
+    return settings;
+}
+
+std::string TableCache::CachePath(const std::string &filename, const std::string &kind) {
+    const auto &directory = Directory();
+    if(directory.empty()) return fmt::format("{}.{}.cache", filename, kind);
+
+    // Files with the same name in different directories are distinguished by the path hash
+    const auto pos = filename.find_last_of('/');
+    const std::string base = pos == std::string::npos ? filename : filename.substr(pos+1);
+    return fmt::format("{}/{}.{:016x}.{}.cache", directory, base, io::Hash(filename), kind);
+}
+
+Table TableCache::Load(const std::string &filename, const std::string &kind, const Parser &parse) {
+    uint64_t source_hash{};
+    if(!Enabled() || !SourceHash(filename, source_hash)) return parse(filename);
+
+    const std::string path = CachePath(filename, kind);
+    Table table;
+    bool cached = false;
+    try {
+        cached = Read(path, kind, source_hash, table);
+    } catch(const std::exception &) {
+        // A corrupted size can request an arbitrary allocation, fall back to parsing
+        cached = false;
+    }
+    if(cached) {
+        spdlog::debug("TableCache: Loaded {} from {}", filename, path);
+        return table;
+    }
+
+    table = parse(filename);
+    if(Write(path, kind, source_hash, table))
+        spdlog::debug("TableCache: Cached {} in {}", filename, path);
+    else
+        spdlog::debug("TableCache: Unable to write cache {}", path);
+    return table;
+}
+
+uint64_t TableCache::PayloadHash(const Table &table) {
+    uint64_t hash = io::Hash(reinterpret_cast<const char*>(table.header.data()),
+                             table.header.size()*sizeof(int64_t));
+    for(const auto &column : table.columns) {
+        hash = io::Hash(reinterpret_cast<const char*>(column.data()),
+                        column.size()*sizeof(double), hash);
+    }
+    return hash;
+}
+
+bool TableCache::Read(const std::string &path, const std::string &kind, uint64_t source_hash, Table &table) {
+    std::ifstream in(path, std::ios::binary);
+    if(!in) return false;
+
+    std::array<char, table_magic.size()> magic{};
+    in.read(magic.data(), magic.size());
+    if(!in || magic != table_magic) return false;
+
+    uint32_t file_version{};
+    std::string file_kind;
+    uint64_t file_hash{}, ncolumns{}, payload{};
+    if(!io::ReadBinary(in, file_version) || file_version != version) return false;
+    if(!io::ReadBinary(in, file_kind) || file_kind != kind) return false;
+    if(!io::ReadBinary(in, file_hash) || file_hash != source_hash) return false;
+
+    Table result;
+    if(!io::ReadBinary(in, result.header)) return false;
+    if(!io::ReadBinary(in, ncolumns)) return false;
+    result.columns.resize(ncolumns);
+    for(auto &column : result.columns) {
+        if(!io::ReadBinary(in, column)) return false;
+    }
+    if(!io::ReadBinary(in, payload) || payload != PayloadHash(result)) {
+        spdlog::warn("TableCache: Cache {} is corrupted, rebuilding", path);
+        return false;
+    }
+
+    table = std::move(result);
+    return true;
+}
+
+bool TableCache::Write(const std::string &path, const std::string &kind, uint64_t source_hash,
+                       const Table &table) {
+    // Write to a temporary file first, such that concurrent jobs never read a partial cache
+    const std::string tmp = fmt::format("{}.{}.tmp", path, getpid());
+    std::ofstream out(tmp, std::ios::binary);
+    if(!out) return false;
+    out.write(table_magic.data(), table_magic.size());
+    io::WriteBinary(out, version);
+    io::WriteBinary(out, kind);
+    io::WriteBinary(out, source_hash);
+    io::WriteBinary(out, table.header);
+    io::WriteSize(out, table.columns.size());
+    for(const auto &column : table.columns) io::WriteBinary(out, column);
+    io::WriteBinary(out, PayloadHash(table));
+    out.close();
+    if(!out || std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
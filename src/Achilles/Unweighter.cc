@@ -6,7 +6,9 @@
 using achilles::PercentileUnweighter;
 
 PercentileUnweighter::PercentileUnweighter(const YAML::Node &node)
-    : m_percentile{node["percentile"].as<double>()/100} {}
+    : m_percentile{node["percentile"].as<double>()/100,
+                   node["compression"] ? node["compression"].as<double>()
+                                       : Percentile::compression_default} {}
 
 void PercentileUnweighter::AddEvent(const achilles::Event &event) {
     m_percentile.Add(event.Weight());
@@ -2,6 +2,7 @@
 #include <chrono>
 #include <ctime>
 #include <iomanip>
+#include <numeric>
 #include <stdexcept>
 #include <utility>
 
@@ -17,23 +18,45 @@ void achilles::Vegas::operator()(const Func<double> &func) {
     std::vector<double> rans(grid.Dims());
     std::vector<double> train_data(grid.Dims()*grid.Bins());
 
-    StatsData results;
-
-    for(size_t i = 0; i < params.ncalls; ++i) {
-        Random::Instance().Generate(rans);
-
-        double wgt = grid(rans);
-        double val = func(rans, wgt);
-        double val2 = val * val;
-
-        results += val;
-
-        for(size_t j = 0; j < grid.Dims(); ++j) {
-            train_data[j * grid.Bins() + grid.FindBin(j, rans[j])] += val2; 
+    // Stratified sampling: each hypercube is sampled a fixed number of times
+    // and the estimates from each hypercube are combined
+    const auto allocation = strata.Allocate(params.ncalls);
+    const auto ntotal = static_cast<double>(std::accumulate(allocation.begin(), allocation.end(), size_t{0}));
+    const auto volume = 1.0/static_cast<double>(strata.NHypercubes());
+    double mean = 0, variance = 0, nfinite = 0;
+    double min = lim::max(), max = lim::lowest();
+
+    for(size_t hcube = 0; hcube < allocation.size(); ++hcube) {
+        const auto ncalls = static_cast<double>(allocation[hcube]);
+        // Scale such that each point is an estimate of the full integral
+        const double scale = ntotal * volume / ncalls;
+        double sum = 0, sum2 = 0;
+        for(size_t i = 0; i < allocation[hcube]; ++i) {
+            Random::Instance().Generate(rans);
+            strata.Map(hcube, rans);
+
+            double wgt = grid(rans);
+            double val = func(rans, wgt);
+            sum += val;
+            sum2 += val * val;
+            strata.AddTrainData(hcube, val);
+
+            if(val != 0) nfinite++;
+            min = std::min(min, val * scale);
+            max = std::max(max, val * scale);
+
+            for(size_t j = 0; j < grid.Dims(); ++j) {
+                train_data[j * grid.Bins() + grid.FindBin(j, rans[j])] += val * val * scale; 
+            }
         }
+        const double hmean = sum / ncalls;
+        mean += volume * hmean;
+        variance += volume * volume * std::max(sum2 / ncalls - hmean * hmean, 0.0) / (ncalls - 1);
     }
 
     grid.Adapt(params.alpha, train_data);
+    strata.Adapt();
+    StatsData results = StatsData::FromMoments(ntotal, nfinite, mean, variance, min, max);
     summary.results.push_back(results);
     summary.sum_results += results;
 }
@@ -55,17 +78,46 @@ void achilles::Vegas::Optimize(const Func<double> &func) {
     }
 }
 
+size_t achilles::Vegas::Sample(std::vector<double> &rans) const {
+    size_t hcube = 0;
+    if(strata.NHypercubes() > 1) {
+        hcube = strata.Select(Random::Instance().Uniform(0.0, 1.0));
+        strata.Map(hcube, rans);
+    }
+    grid(rans);
+    return hcube;
+}
+
 double achilles::Vegas::GenerateWeight(const std::vector<double> &rans) const {
-    return grid.GenerateWeight(rans); 
+    if(strata.NHypercubes() == 1) return grid.GenerateWeight(rans); 
+
+    // Invert the grid to find the hypercube the point was sampled in
+    double jacobian = 1.0;
+    size_t hcube = 0;
+    for(size_t i = 0; i < grid.Dims(); ++i) {
+        const auto bin = grid.FindBin(i, rans[i]);
+        const double width = grid.width(i, bin);
+        const double y = (static_cast<double>(bin) + (rans[i] - grid.lower_edge(i, bin)) / width)
+                       / static_cast<double>(grid.Bins());
+        jacobian *= width * static_cast<double>(grid.Bins());
+        hcube = hcube * strata.NStrata() + strata.Stratum(y);
+    }
+    return jacobian / strata.Density(hcube);
 }
 
 void achilles::Vegas::Adapt(const std::vector<double> &train_data) {
     grid.Adapt(params.alpha, train_data);
+    strata.Adapt(false);
 }
 
 void achilles::Vegas::Refine() {
     grid.Split();
-    params.ncalls *= 2;
+    SetCalls(2*params.ncalls);
+}
+
+void achilles::Vegas::SetCalls(size_t ncalls) {
+    params.ncalls = ncalls;
+    strata.Resize(params.ncalls, params.max_hypercubes);
 }
 
 achilles::VegasSummary achilles::Vegas::Summary() const {
@@ -76,6 +128,18 @@ achilles::VegasSummary achilles::Vegas::Summary() const {
     return summary;
 }
 
+void achilles::Vegas::SaveState(std::ostream &out) const {
+    io::WriteBinary(out, params);
+    summary.SaveState(out);
+    grid.SaveState(out);
+    strata.SaveState(out);
+}
+
+bool achilles::Vegas::LoadState(std::istream &in) {
+    return io::ReadBinary(in, params) && summary.LoadState(in) && grid.LoadState(in)
+        && strata.LoadState(in);
+}
+
 void achilles::Vegas::PrintIteration() const {
     std::cout << fmt::format("{:3d}   {:^8.5e} +/- {:^8.5e}    {:^8.5e} +/- {:^8.5e}",
             summary.results.size(), summary.results.back().Mean(), summary.results.back().Error(),
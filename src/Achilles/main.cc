@@ -1,3 +1,4 @@
+#include "Achilles/Analysis.hh"
 #include "Achilles/EventGen.hh"
 #include "Achilles/FinalStateMapper.hh"
 #include "Achilles/HadronicMapper.hh"
@@ -51,6 +52,7 @@ R"(
       achilles --display-ff
       achilles --display-int-models
       achilles --display-nuc-models
+      achilles --display-analyses
       achilles (-h | --help)
       achilles --version
 
@@ -64,6 +66,7 @@ R"(
       --display-ff                          Display the available form factors
       --display-int-models                  Display the available cascade interaction models
       --display-nuc-models                  Display the available nuclear interaction models
+      --display-analyses                    Display the available analyses
 )";
 
 void GenerateEvents(const std::string &runcard, const std::vector<std::string> &shargs) {
@@ -110,6 +113,11 @@ int main(int argc, char *argv[]) {
         return 0;
     }
 
+    if(args["--display-analyses"].asBool()) {
+        achilles::AnalysisFactory::Display();
+        return 0;
+    }
+
     std::string runcard = "run.yml";
     if(args["<input>"].isString()) runcard = args["<input>"].asString();
     
@@ -1,5 +1,5 @@
 #include "plugins/HepMC3/HepMC3EventWriter.hh"
-#include "gzstream/gzstream.h"
+#include "Achilles/ParallelGzip.hh"
 #include "HepMC3/GenEvent.h"
 #include "HepMC3/GenVertex.h"
 #include "HepMC3/GenParticle.h"
@@ -13,13 +13,14 @@
 using achilles::HepMC3Writer;
 using namespace HepMC3;
 
-std::shared_ptr<std::ostream> HepMC3Writer::InitializeStream(const std::string &filename, bool zipped) {
+std::shared_ptr<std::ostream> HepMC3Writer::InitializeStream(const std::string &filename, bool zipped,
+                                                             int level, size_t threads) {
     std::shared_ptr<std::ostream> output = nullptr;
     if(zipped) {
         std::string zipname = filename;
         if(filename.substr(filename.size() - 3) != ".gz")
             zipname += std::string(".gz");
-        output = std::make_shared<ogzstream>(zipname.c_str());
+        output = std::make_shared<ParallelGzipStream>(zipname, level, threads);
     } else {
         output = std::make_shared<std::ofstream>(filename);
     }
@@ -80,9 +81,9 @@ void HepMC3Writer::Write(const achilles::Event &event) {
     // evt.shift_position_to(position);
 
     // Load in particle information
-    const std::vector<achilles::Particle> hadrons = event.Hadrons();
+    const auto &hadrons = event.Hadrons();
     // spdlog::info("nhadrons = {}" , hadrons.size());
-    const std::vector<achilles::Particle> leptons = event.Leptons();
+    const auto &leptons = event.Leptons();
     // TODO: Clean this up
     const auto nuc_mass = achilles::ParticleInfo(event.CurrentNucleus() -> ID()).Mass();
     const HepMC3::FourVector initMass{0, 0, 0, nuc_mass};
@@ -96,7 +97,7 @@ void HepMC3Writer::Write(const achilles::Event &event) {
         if(hadrons[idx].Status() == ParticleStatus::initial_state)
             break;
     }
-    const auto initHadron = hadrons[idx];
+    const auto &initHadron = hadrons[idx];
     HepMC3::FourVector p2Mom{initHadron.Px(), initHadron.Py(), initHadron.Pz(), initHadron.E()};
     nucleon = std::make_shared<GenParticle>(p2Mom, int(initHadron.ID()), 3);
 
@@ -112,7 +113,7 @@ void HepMC3Writer::Write(const achilles::Event &event) {
     // TODO: Get maximum neutrino energy from the beam
     const HepMC3::FourVector initBeam{10000, 0, 0, 10000};
     GenParticlePtr p3In = std::make_shared<GenParticle>(initBeam, leptons[0].ID(), 4);
-    const auto initLepton = leptons[0];
+    const auto &initLepton = leptons[0];
     const HepMC3::FourVector p3Mom{initLepton.Px(), initLepton.Py(), initLepton.Pz(), initLepton.E()};
     GenParticlePtr p3 = std::make_shared<GenParticle>(p3Mom, int(initLepton.ID()), 4);
     recoilMom += initLepton.Momentum();
@@ -129,7 +130,7 @@ void HepMC3Writer::Write(const achilles::Event &event) {
 
     // Add remaining leptons
     for(size_t i = 1; i < leptons.size(); ++i) {
-        const auto currPart = leptons[i];
+        const auto &currPart = leptons[i];
         const HepMC3::FourVector mom{currPart.Px(), currPart.Py(), currPart.Pz(), currPart.E()};
         GenParticlePtr p = std::make_shared<GenParticle>(mom, int(currPart.ID()), 1);
         v2->add_particle_out(p);
@@ -139,7 +140,7 @@ void HepMC3Writer::Write(const achilles::Event &event) {
     // Add remaining hard interaction hadrons
     for(size_t i = 0; i < hadrons.size(); ++i) {
         if(i == idx) continue;
-        const auto currPart = hadrons[i];
+        const auto &currPart = hadrons[i];
         const HepMC3::FourVector mom{currPart.Px(), currPart.Py(), currPart.Pz(), currPart.E()};
         GenParticlePtr p = std::make_shared<GenParticle>(mom, int(currPart.ID()), 1);
         v2->add_particle_out(p);
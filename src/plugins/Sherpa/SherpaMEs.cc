@@ -23,6 +23,7 @@
 #include "Achilles/Utilities.hh"
 #include "plugins/Sherpa/Channels.hh"
 #include <bitset>
+#include <set>
 
 using namespace SHERPA;
 using namespace PHASIC;
@@ -351,6 +352,21 @@ std::vector<FormFactorInfo> achilles::SherpaMEs::FormFactors(int hpid, int vpid)
     return form_factors;
 }
 
+std::vector<int> achilles::SherpaMEs::Bosons(int hpid) const {
+    const std::vector<MODEL::Single_Vertex> &vertices(MODEL::s_model->OriginalVertices());
+    std::set<int> bosons;
+    for(const auto &vertex : vertices) {
+        if(vertex.FormFactor.empty()) continue;
+        if(std::find(vertex.in.begin(), vertex.in.end(), -hpid) == vertex.in.end()) continue;
+        // Only the exchanged bosons are kept, and not the partner hadron of a transition vertex
+        for(const auto &flavour : vertex.in) {
+            if(!flavour.IsBoson()) continue;
+            bosons.insert(static_cast<int>(static_cast<long int>(flavour)));
+        }
+    }
+    return {bosons.begin(), bosons.end()};
+}
+
 void achilles::SherpaMEs::RegisterParticles() const {
     for(const auto &particleEntry : ATOOLS::s_kftable) {
         auto pid = particleEntry.first;
@@ -37,6 +37,8 @@ class MockNucleus : public trompeloeil::mock_interface<achilles::Nucleus> {
     MAKE_CONST_MOCK0(Radius, const double&(), noexcept override);
     MAKE_CONST_MOCK1(Rho, double(const double&), noexcept override);
     MAKE_CONST_MOCK0(NNucleons, size_t(), noexcept override);
+    MAKE_CONST_MOCK0(NProtons, size_t(), noexcept override);
+    MAKE_CONST_MOCK0(NNeutrons, size_t(), noexcept override);
     MAKE_CONST_MOCK0(GetPotential, std::shared_ptr<achilles::Potential>(), noexcept override);
 };
 
@@ -54,6 +56,7 @@ class MockSherpaME : public trompeloeil::mock_interface<achilles::SherpaMEs> {
     static constexpr bool trompeloeil_movable_mock = true;
     IMPLEMENT_CONST_MOCK3(Calc);
     IMPLEMENT_CONST_MOCK2(FormFactors);
+    IMPLEMENT_CONST_MOCK1(Bosons);
 };
 
 class MockInteraction : public trompeloeil::mock_interface<achilles::Interactions> {
@@ -69,6 +72,7 @@ class MockBeam : public trompeloeil::mock_interface<achilles::Beam> {
     IMPLEMENT_CONST_MOCK0(BeamIDs);
     IMPLEMENT_CONST_MOCK4(GenerateWeight);
     IMPLEMENT_CONST_MOCK0(NVariables);
+    IMPLEMENT_CONST_MOCK1(SelectBeam);
 };
 
 class MockEvent : public trompeloeil::mock_interface<achilles::Event> {
@@ -77,6 +81,7 @@ class MockEvent : public trompeloeil::mock_interface<achilles::Event> {
     IMPLEMENT_MOCK0(Hadrons);
     IMPLEMENT_MOCK1(InitializeLeptons);
     IMPLEMENT_MOCK1(InitializeHadrons);
+    IMPLEMENT_MOCK0(GenerateConfig);
     MAKE_CONST_MOCK0(Momentum, const std::vector<achilles::FourVector>&());
     MAKE_MOCK0(Momentum, std::vector<achilles::FourVector>&());
     IMPLEMENT_CONST_MOCK0(Particles);
@@ -110,7 +115,7 @@ class MockMapper : public trompeloeil::mock_interface<achilles::Mapper<achilles:
 
 class MockPSBuilder : public trompeloeil::mock_interface<achilles::PSBuilder> {
     static constexpr bool trompeloeil_movable_mock = true;
-    IMPLEMENT_MOCK3(Beam);
+    IMPLEMENT_MOCK4(Beam);
     IMPLEMENT_MOCK3(Hadron);
     IMPLEMENT_MOCK2(FinalState);
 };
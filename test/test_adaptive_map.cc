@@ -127,6 +127,24 @@ TEST_CASE("Serializing / Deserializing Adaptive Map", "[vegas]") {
         CHECK_THAT(map.Edges(i), Catch::Matchers::Approx(map2.Edges(i)));
 }
 
+TEST_CASE("Binary save / load of Adaptive Map", "[vegas]") {
+    achilles::AdaptiveMap map(4, 4);
+    map.Split(achilles::AdaptiveMapSplit::third);
+
+    std::stringstream data;
+    map.SaveState(data);
+
+    achilles::AdaptiveMap map2;
+    REQUIRE(map2.LoadState(data));
+
+    CHECK(map.Dims() == map2.Dims());
+    CHECK(map.Bins() == map2.Bins());
+    CHECK(map.Hist() == map2.Hist());
+
+    std::stringstream truncated(data.str().substr(0, 16));
+    CHECK_FALSE(map2.LoadState(truncated));
+}
+
 TEST_CASE("YAML encoding / decoding Adaptive Map", "[vegas]") {
     achilles::AdaptiveMap map(4, 4);
 
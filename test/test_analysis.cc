@@ -0,0 +1,111 @@
+#include "catch2/catch.hpp"
+
+#include "Achilles/Analysis.hh"
+#include "Achilles/Event.hh"
+#include "Achilles/Particle.hh"
+
+#include "yaml-cpp/yaml.h"
+
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+namespace {
+
+class CountingAnalysis : public achilles::Analysis, achilles::RegistrableAnalysis<CountingAnalysis> {
+    public:
+        CountingAnalysis(const YAML::Node&) {}
+        void Process(const achilles::Event&) override { ++nevents; }
+        void Finalize(double xsec_, double sum_weights_) override {
+            xsec = xsec_;
+            sum_weights = sum_weights_;
+        }
+        void Save(const std::string&) const override {}
+
+        static std::unique_ptr<achilles::Analysis> Construct(const YAML::Node &node) {
+            return std::make_unique<CountingAnalysis>(node);
+        }
+        static std::string Name() { return "CountingAnalysis"; }
+
+        // Not atomic, since the handler serializes the calls to Process
+        size_t nevents{};
+        double xsec{}, sum_weights{};
+};
+
+achilles::Event MakeEvent(double weight) {
+    static constexpr achilles::FourVector lepton{1000, 0, 0, 1000};
+    achilles::Event event;
+    event.Weight() = weight;
+    event.Leptons().emplace_back(achilles::PID::electron(), lepton, achilles::ThreeVector{},
+                                 achilles::ParticleStatus::final_state);
+    return event;
+}
+
+}
+
+TEST_CASE("Analysis handler", "[Analysis]") {
+    SECTION("Runs the requested analyses") {
+        auto node = YAML::Load(R"node(
+Analyses:
+  - Name: CountingAnalysis
+)node");
+        achilles::AnalysisHandler handler(node);
+        REQUIRE(handler.NAnalyses() == 1);
+
+        // Events are passed from multiple threads
+        static constexpr size_t nthreads = 4, nevents = 100;
+        const auto event = MakeEvent(0.5);
+        std::vector<std::thread> threads;
+        for(size_t i = 0; i < nthreads; ++i) {
+            threads.emplace_back([&handler, &event]() {
+                for(size_t j = 0; j < nevents; ++j) handler.Process(event);
+            });
+        }
+        for(auto &thread : threads) thread.join();
+        handler.Process(std::vector<achilles::Event>{MakeEvent(1), MakeEvent(2)});
+        CHECK(handler.SumWeights() == Approx(0.5*nthreads*nevents + 3));
+
+        handler.Finalize(10);
+        handler.Save();
+        const auto &analysis = dynamic_cast<const CountingAnalysis&>(handler.GetAnalysis(0));
+        CHECK(analysis.nevents == nthreads*nevents + 2);
+        CHECK(analysis.xsec == 10);
+        CHECK(analysis.sum_weights == handler.SumWeights());
+    }
+
+    SECTION("Final state energy distributions") {
+        auto node = YAML::Load(R"node(
+Output: test_
+Analyses:
+  - Name: FinalStateEnergy
+    PIDs: [11]
+    Bins: 10
+    Range: [0, 2000]
+)node");
+        {
+            achilles::AnalysisHandler handler(node);
+            handler.Process(MakeEvent(2));
+            handler.Finalize(4);
+            handler.Save();
+        }
+
+        // The histogram is normalized to the cross section
+        std::ifstream in("test_FinalStateEnergy_11.txt");
+        REQUIRE(in.good());
+        std::string line;
+        std::getline(in, line);
+        CHECK(line == "FinalStateEnergy_11");
+        std::getline(in, line);
+        double lower{}, upper{}, value{}, error{}, integral{};
+        while(in >> lower >> upper >> value >> error) integral += value*(upper - lower);
+        CHECK(integral == Approx(4));
+        std::remove("test_FinalStateEnergy_11.txt");
+    }
+
+    SECTION("Invalid setups") {
+        CHECK_THROWS_AS(achilles::AnalysisHandler(YAML::Load("Analyses: [{Name: Unknown}]")),
+                        std::runtime_error);
+        CHECK_THROWS_AS(achilles::AnalysisHandler(YAML::Load("Libraries: [libNotAnAnalysis.so]")),
+                        std::runtime_error);
+    }
+}
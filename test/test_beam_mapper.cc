@@ -1,6 +1,7 @@
 #include "catch2/catch.hpp"
 
 #include "Achilles/BeamMapper.hh"
+#include "Achilles/Beams.hh"
 #include "mock_classes.hh"
 #include "Approx.hh"
 
@@ -57,3 +58,53 @@ TEST_CASE("BeamMapper", "[PhaseSpace]") {
         }
     }
 }
+
+TEST_CASE("BeamSpeciesMapper", "[PhaseSpace]") {
+    YAML::Node beams = YAML::Load(R"beam(
+- Beam:
+    PID: 12
+    Beam Params:
+      Type: Spectrum
+      Histogram: flux/dummy.dat
+- Beam:
+    PID: 14
+    Beam Params:
+      Type: Spectrum
+      Histogram: flux/miniboone.dat)beam");
+    auto beam = std::make_shared<achilles::Beam>(beams.as<achilles::Beam>());
+    auto selection = std::make_shared<achilles::BeamSelection>();
+    const std::vector<achilles::PID> species{achilles::PID(12), achilles::PID(14)};
+
+    achilles::BeamSpeciesMapper::SpeciesMappers mappers;
+    for(const auto &pid : species) mappers[pid] = std::make_unique<achilles::BeamMapper>(0, beam, pid);
+    achilles::BeamSpeciesMapper mapper(beam, selection, std::move(mappers));
+    CHECK(mapper.NDims() == 2);
+
+    SECTION("Forward and Backward pass") {
+        for(const auto &rans : std::vector<std::vector<double>>{{0.1, 0.3}, {0.5, 0.5}, {0.9, 0.7}}) {
+            std::vector<achilles::FourVector> mom(1);
+            mapper.GeneratePoint(mom, rans);
+            CHECK(selection -> pid == beam -> SelectBeam(rans[0]));
+
+            std::vector<double> new_rans;
+            double wgt = mapper.GenerateWeight(mom, new_rans);
+            CHECK_THAT(new_rans, Catch::Matchers::Approx(rans));
+
+            // The density is that of the beam of the selected species
+            std::vector<double> beam_rans(1);
+            CHECK(wgt == Approx(1.0/beam -> GenerateWeight(selection -> pid, mom[0], beam_rans, 0)));
+        }
+    }
+
+    SECTION("Species follow the integrated fluxes") {
+        static constexpr size_t npoints = 1000;
+        size_t nnue = 0;
+        std::vector<achilles::FourVector> mom(1);
+        for(size_t i = 0; i < npoints; ++i) {
+            mapper.GeneratePoint(mom, {(static_cast<double>(i) + 0.5)/npoints, 0.5});
+            if(selection -> pid == species[0]) ++nnue;
+        }
+        CHECK(static_cast<double>(nnue)/npoints
+              == Approx(beam -> Fraction(species[0])).margin(1.0/npoints));
+    }
+}
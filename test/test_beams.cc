@@ -1,9 +1,15 @@
 #include "catch2/catch.hpp"
 
 #include "Achilles/Beams.hh"
+#include "Achilles/Constants.hh"
+#include "fmt/format.h"
 #include "yaml-cpp/yaml.h"
 
+#include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <random>
 
 TEST_CASE("Spectrum Beam", "[Beams]") {
     SECTION("Parse headers") {
@@ -42,6 +48,81 @@ TEST_CASE("Spectrum Beam", "[Beams]") {
     }
 }
 
+TEST_CASE("Spectrum Sampling", "[Beams]") {
+    SECTION("Invalid sampling throws") {
+        YAML::Node beam = YAML::Load("{Histogram: flux/dummy.dat, Sampling: Importance}");
+        CHECK_THROWS_WITH(achilles::Spectrum(beam),
+                          "Beam::Spectrum: Invalid sampling Importance, expected Flux or Uniform");
+    }
+
+    auto filename = GENERATE(as<std::string>{}, "flux/miniboone.dat", "flux/miniboone_nu.dat",
+                             "flux/T2K_nu.dat");
+    YAML::Node beam = YAML::Load(fmt::format("Histogram: {}", filename));
+    achilles::Spectrum spectrum(beam);
+    REQUIRE(spectrum.SampleFlux());
+
+    SECTION("Inverse CDF inverts the CDF") {
+        const double total = spectrum.FluxCDF(spectrum.MaxEnergy());
+        for(size_t i = 0; i <= 100; ++i) {
+            const double cdf = total*static_cast<double>(i)/100;
+            CHECK(spectrum.FluxCDF(spectrum.InverseFluxCDF(cdf)) == Approx(cdf).margin(1e-10*total));
+        }
+    }
+
+    SECTION("Sampled energies respect the threshold and invert the weight") {
+        const double smin = pow(achilles::Constant::mN + 400, 2);
+        const double threshold = sqrt(smin) - achilles::Constant::mN + 5;
+        const double cdf_min = spectrum.FluxCDF(threshold);
+        const double fraction = (spectrum.FluxCDF(spectrum.MaxEnergy()) - cdf_min)
+                              / spectrum.FluxCDF(spectrum.MaxEnergy());
+        std::vector<double> rans0(1);
+        const double wgt0 = spectrum.GenerateWeight(spectrum.Flux({0.5}, 0), rans0, 0);
+        for(size_t i = 0; i <= 20; ++i) {
+            std::vector<double> rans{static_cast<double>(i)/20};
+            auto mom = spectrum.Flux(rans, smin);
+            CHECK(mom.E() >= threshold);
+            CHECK(mom.E() <= spectrum.MaxEnergy());
+
+            std::vector<double> rans2(1);
+            double wgt = spectrum.GenerateWeight(mom, rans2, smin);
+            CHECK(rans2[0] == Approx(rans[0]).margin(1e-8));
+            // The weight is the fraction of the flux above threshold
+            CHECK(wgt == Approx(fraction*wgt0));
+        }
+    }
+}
+
+TEST_CASE("Spectrum Sampling Variance", "[Beams]") {
+    // Estimate the flux averaged energy above threshold with both sampling modes
+    YAML::Node flux_beam = YAML::Load("{Histogram: flux/miniboone.dat, Sampling: Flux}");
+    YAML::Node uniform_beam = YAML::Load("{Histogram: flux/miniboone.dat, Sampling: Uniform}");
+    achilles::Spectrum flux(flux_beam), uniform(uniform_beam);
+    REQUIRE(!uniform.SampleFlux());
+
+    const double smin = pow(achilles::Constant::mN + 200, 2);
+    auto estimate = [&](const achilles::Spectrum &spectrum) {
+        std::mt19937 gen(123456789);
+        std::uniform_real_distribution<double> dist;
+        constexpr size_t nevents = 100000;
+        double sum = 0, sum2 = 0;
+        for(size_t i = 0; i < nevents; ++i) {
+            std::vector<double> rans{dist(gen)};
+            auto mom = spectrum.Flux(rans, smin);
+            double value = spectrum.GenerateWeight(mom, rans, smin)*mom.E();
+            sum += value;
+            sum2 += value*value;
+        }
+        const double mean = sum/nevents;
+        return std::make_pair(mean, sqrt((sum2/nevents - mean*mean)/nevents));
+    };
+
+    auto flux_result = estimate(flux);
+    auto uniform_result = estimate(uniform);
+    const double sigma = std::hypot(flux_result.second, uniform_result.second);
+    CHECK(std::abs(flux_result.first - uniform_result.first) < 4*sigma);
+    CHECK(flux_result.second < uniform_result.second/2);
+}
+
 TEST_CASE("From YAML", "[Beams]") {
     SECTION("Multiple Monochromatic Beams") {
         YAML::Node beams = YAML::Load(R"beam(
@@ -89,4 +170,92 @@ Beams:
     
         CHECK_THROWS_WITH(beams["Beams"].as<achilles::Beam>(), "Multiple beams exist for PID: 12");
     }
+    SECTION("Mixed Beam Fractions") {
+        YAML::Node beams = YAML::Load(R"beam(
+
+Beams:
+  - Beam:
+      PID: 12
+      Beam Params:
+        Type: Spectrum
+        Histogram: flux/miniboone_nu.dat
+  - Beam:
+      PID: 14
+      Beam Params:
+        Type: Spectrum
+        Histogram: flux/miniboone.dat)beam"
+        );
+
+        auto beam = beams["Beams"].as<achilles::Beam>();
+        const double nue = beam.at(achilles::PID(12)) -> FluxIntegral();
+        const double numu = beam.at(achilles::PID(14)) -> FluxIntegral();
+        CHECK(beam.Fraction(achilles::PID(12)) == Approx(nue/(nue + numu)));
+        CHECK(beam.Fraction(achilles::PID(14)) == Approx(numu/(nue + numu)));
+
+        const double boundary = beam.Fraction(achilles::PID(12));
+        CHECK(beam.SelectBeam(0) == achilles::PID(12));
+        CHECK(beam.SelectBeam(0.99*boundary) == achilles::PID(12));
+        CHECK(beam.SelectBeam(boundary + 0.01*(1 - boundary)) == achilles::PID(14));
+        CHECK(beam.SelectBeam(1) == achilles::PID(14));
+    }
+
+    SECTION("Mixed Beams need the same flux type and units") {
+        YAML::Node units = YAML::Load(R"beam(
+  - Beam:
+      PID: 12
+      Beam Params:
+        Type: Spectrum
+        Histogram: flux/dummy.dat
+  - Beam:
+      PID: 14
+      Beam Params:
+        Type: Spectrum
+        Histogram: flux/miniboone.dat)beam");
+        CHECK_THROWS_AS(units.as<achilles::Beam>(), std::runtime_error);
+
+        YAML::Node types = YAML::Load(R"beam(
+  - Beam:
+      PID: 12
+      Beam Params:
+        Type: Monochromatic
+        Energy: 100
+  - Beam:
+      PID: 14
+      Beam Params:
+        Type: Spectrum
+        Histogram: flux/miniboone.dat)beam");
+        CHECK_THROWS_AS(types.as<achilles::Beam>(), std::runtime_error);
+    }
+
+    SECTION("Mixed Beam Fractions use the integral over the bin widths") {
+        // Fluxes per MeV with different bin widths, but the same total flux
+        {
+            std::ofstream narrow("narrow_flux.dat");
+            narrow << "Achilles\nTest Flux\nunits: v/cm^2/POT/MeV\n"
+                   << "lower edge upper edge value error\n";
+            for(size_t i = 0; i < 10; ++i) narrow << 10*i << " " << 10*(i+1) << " 1 0\n";
+            std::ofstream wide("wide_flux.dat");
+            wide << "Achilles\nTest Flux\nunits: v/cm^2/POT/MeV\n"
+                 << "lower edge upper edge value error\n"
+                 << "0 50 1 0\n50 100 1 0\n";
+        }
+        YAML::Node beams = YAML::Load(R"beam(
+  - Beam:
+      PID: 12
+      Beam Params:
+        Type: Spectrum
+        Histogram: narrow_flux.dat
+  - Beam:
+      PID: 14
+      Beam Params:
+        Type: Spectrum
+        Histogram: wide_flux.dat)beam");
+
+        auto beam = beams.as<achilles::Beam>();
+        CHECK(beam.at(achilles::PID(12)) -> FluxIntegral() == Approx(100));
+        CHECK(beam.Fraction(achilles::PID(12)) == Approx(0.5));
+        CHECK(beam.Fraction(achilles::PID(14)) == Approx(0.5));
+        std::remove("narrow_flux.dat");
+        std::remove("wide_flux.dat");
+    }
 }
@@ -94,6 +94,8 @@ TEST_CASE("Evolve States: 1 nucleon", "[Cascade]") {
         auto nucleus = std::make_shared<MockNucleus>();
         std::shared_ptr<achilles::Nucleus> tmp = nucleus;
 
+        REQUIRE_CALL(event, GenerateConfig())
+            .TIMES(1);
         REQUIRE_CALL(event, Hadrons())
             .TIMES(AT_LEAST(2))
             .LR_RETURN((hadrons));
@@ -102,7 +104,7 @@ TEST_CASE("Evolve States: 1 nucleon", "[Cascade]") {
             .LR_RETURN((tmp));
 
         REQUIRE_CALL(*nucleus, Nucleons())
-            .TIMES(2)
+            .TIMES(4)
             .LR_RETURN((hadrons));
         REQUIRE_CALL(*nucleus, GetPotential())
             .TIMES(1)
@@ -236,6 +238,8 @@ TEST_CASE("Evolve States: 3 nucleons", "[Cascade]") {
         auto nucleus = std::make_shared<MockNucleus>();
         std::shared_ptr<achilles::Nucleus> tmp = nucleus;
 
+        REQUIRE_CALL(event, GenerateConfig())
+            .TIMES(1);
         REQUIRE_CALL(event, Hadrons())
             .TIMES(AT_LEAST(2))
             .LR_RETURN((hadrons));
@@ -244,7 +248,7 @@ TEST_CASE("Evolve States: 3 nucleons", "[Cascade]") {
             .LR_RETURN((tmp));
 
         REQUIRE_CALL(*nucleus, Nucleons())
-            .TIMES(2)
+            .TIMES(4)
             .LR_RETURN((hadrons));
         REQUIRE_CALL(*nucleus, GetPotential())
             .TIMES(AT_LEAST(1))
@@ -146,6 +146,21 @@ TEST_CASE("CutCollection", "[Cuts]") {
         CHECK(cuts.EvaluateCuts({part1, part2}) == pass_cuts);
     }
 
+    SECTION("Only final state particles with cuts are checked") {
+        YAML::Node node;
+        node["min"] = 10;
+        auto cut = achilles::CutFactory<achilles::OneParticleCut>::InitializeCut("Energy", node);
+        cuts.AddCut({achilles::PID::proton()}, std::move(cut));
+        achilles::FourVector soft{1, 0, 0, 0};
+        std::vector<achilles::Particle> nucleons(40, achilles::Particle(achilles::PID::proton(), soft));
+        for(auto &nucleon : nucleons) nucleon.Status() = achilles::ParticleStatus::background;
+        CHECK(cuts.EvaluateCuts(achilles::ParticleView(nucleons, {part1, part2})) == true);
+
+        nucleons.back().Status() = achilles::ParticleStatus::final_state;
+        CHECK(cuts.EvaluateCuts(achilles::ParticleView(nucleons, {part1, part2})) == false);
+        CHECK(cuts.CutEfficiency() == 0.5);
+    }
+
     SECTION("YAML correctly builds CutCollection") {
         YAML::Node node = YAML::Load(R"node(
         cuts:
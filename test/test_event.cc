@@ -17,10 +17,9 @@ TEST_CASE("Initialize Event Parameters", "[Event]") {
     static constexpr achilles::FourVector hadron1{1560.42, -78.4858, -204.738, 1226.89};
 
     std::vector<achilles::FourVector> moms = {hadron0, lepton0, lepton1, hadron1};
-    achilles::Particles particles = {{achilles::PID::proton(), hadron0}};
 
-    REQUIRE_CALL(*nuc, GenerateConfig())
-        .TIMES(1);
+    // The configuration is only generated when needed
+    FORBID_CALL(*nuc, GenerateConfig());
     REQUIRE_CALL(*nuc, NNucleons())
         .LR_RETURN((12UL))
         .TIMES(1);
@@ -35,9 +34,11 @@ TEST_CASE("Initialize Event Parameters", "[Event]") {
     }
 
     SECTION("Initialize Particles") {
-        REQUIRE_CALL(*nuc, Nucleons())
-            .LR_RETURN((particles))
-            .TIMES(5);
+        ALLOW_CALL(*nuc, NProtons())
+            .LR_RETURN((6UL));
+        ALLOW_CALL(*nuc, NNeutrons())
+            .LR_RETURN((6UL));
+        FORBID_CALL(*nuc, Nucleons());
 
         achilles::Process_Info info;
         info.m_ids = {achilles::PID::electron(), achilles::PID::electron()};
@@ -107,12 +108,33 @@ TEST_CASE("Initialize Event Parameters", "[Event]") {
                                      {achilles::PID::neutron(), hadron0},
                                      {achilles::PID::neutron(), hadron0},
                                      {achilles::PID::neutron(), hadron0}};
+        REQUIRE_CALL(*nuc, GenerateConfig())
+            .TIMES(1);
         REQUIRE_CALL(*nuc, Nucleons())
             .LR_RETURN((final))
-            .TIMES(AT_LEAST(13));
+            .TIMES(1);
 
         event.Finalize();
         CHECK(event.Remnant().PID() == 1000050110);
         CHECK(event.Remnant().Mass() == 11*achilles::Constant::mN);
     }
+
+    SECTION("Finalizing keeps the order of the remaining hadrons") {
+        achilles::Particles final = {{achilles::PID::proton(), hadron0, {}, achilles::ParticleStatus::initial_state},
+                                     {achilles::PID::proton(), hadron0},
+                                     {achilles::PID::neutron(), hadron0},
+                                     {achilles::PID::proton(), hadron1, {}, achilles::ParticleStatus::final_state},
+                                     {achilles::PID::neutron(), hadron0}};
+        REQUIRE_CALL(*nuc, GenerateConfig())
+            .TIMES(1);
+        REQUIRE_CALL(*nuc, Nucleons())
+            .LR_RETURN((final))
+            .TIMES(1);
+
+        event.Finalize();
+        REQUIRE(event.Hadrons().size() == 2);
+        CHECK(event.Hadrons()[0].Status() == achilles::ParticleStatus::initial_state);
+        CHECK(event.Hadrons()[1].Status() == achilles::ParticleStatus::final_state);
+        CHECK(event.Hadrons()[1].Momentum() == hadron1);
+    }
 }
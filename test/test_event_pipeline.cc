@@ -0,0 +1,98 @@
+#include "catch2/catch.hpp"
+
+#include "Achilles/BoundedQueue.hh"
+#include "Achilles/Event.hh"
+#include "Achilles/FourVector.hh"
+#include "Achilles/Particle.hh"
+#include "Achilles/EventPipeline.hh"
+
+#include <numeric>
+#include <thread>
+
+TEST_CASE("Bounded queue", "[Pipeline]") {
+    SECTION("Capacity is rounded to a power of two") {
+        achilles::BoundedQueue<int> queue(5);
+        CHECK(queue.Capacity() == 8);
+        CHECK(queue.Empty());
+    }
+
+    SECTION("First in, first out until full") {
+        achilles::BoundedQueue<int> queue(4);
+        for(int i = 0; i < 4; ++i) CHECK(queue.TryPush(int{i}));
+        CHECK_FALSE(queue.TryPush(4));
+        CHECK(queue.Size() == 4);
+
+        int value{};
+        for(int i = 0; i < 4; ++i) {
+            CHECK(queue.TryPop(value));
+            CHECK(value == i);
+        }
+        CHECK_FALSE(queue.TryPop(value));
+    }
+
+    SECTION("Multiple producers and consumers") {
+        static constexpr size_t nthreads = 4, nvalues = 10000;
+        achilles::BoundedQueue<size_t> queue(16);
+        std::vector<size_t> sums(nthreads);
+        std::vector<std::thread> threads;
+        for(size_t i = 0; i < nthreads; ++i) {
+            threads.emplace_back([&queue, i]() {
+                for(size_t j = 0; j < nvalues; ++j) queue.Push(i*nvalues + j + 1);
+            });
+            threads.emplace_back([&queue, &sums, i]() {
+                size_t value{};
+                for(size_t j = 0; j < nvalues; ++j) {
+                    while(!queue.TryPop(value)) std::this_thread::yield();
+                    sums[i] += value;
+                }
+            });
+        }
+        for(auto &thread : threads) thread.join();
+
+        const size_t total = nthreads*nvalues;
+        CHECK(std::accumulate(sums.begin(), sums.end(), size_t{0}) == total*(total + 1)/2);
+        CHECK(queue.Empty());
+    }
+}
+
+TEST_CASE("Event pipeline", "[Pipeline]") {
+    static constexpr size_t nworkers = 3, nevents = 1000;
+    std::vector<achilles::EventPipeline::Stage> stages;
+    for(size_t i = 0; i < nworkers; ++i)
+        stages.emplace_back([](achilles::Event &event) { event.Weight() *= 2; });
+
+    // The writer is only called from a single thread
+    double total{};
+    size_t nwritten{};
+    achilles::EventPipeline pipeline(std::move(stages), 8, [&](const achilles::Event &event) {
+        total += event.Weight();
+        ++nwritten;
+    }, 12345);
+    CHECK(pipeline.NWorkers() == nworkers);
+
+    for(size_t i = 0; i < nevents; ++i) {
+        achilles::Event event;
+        event.Weight() = 1;
+        if(i % 2 == 0) pipeline.Push(std::move(event));
+        else pipeline.PushProcessed(std::move(event));
+    }
+    pipeline.Finish();
+
+    CHECK(nwritten == nevents);
+    CHECK(total == Approx(1.5*nevents));
+
+    auto stats = pipeline.Stats();
+    REQUIRE(stats.size() == 3);
+    CHECK(stats[0].processed == nevents);
+    CHECK(stats[1].processed == nevents/2);
+    CHECK(stats[2].processed == nevents);
+    CHECK(stats[1].max_depth <= 8);
+}
+
+TEST_CASE("Event pipeline propagates errors", "[Pipeline]") {
+    std::vector<achilles::EventPipeline::Stage> stages;
+    stages.emplace_back([](achilles::Event&) { throw std::runtime_error("stage failed"); });
+    achilles::EventPipeline pipeline(std::move(stages), 4, [](const achilles::Event&) {}, 1);
+    pipeline.Push(achilles::Event{});
+    CHECK_THROWS_WITH(pipeline.Finish(), "stage failed");
+}
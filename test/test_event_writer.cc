@@ -4,9 +4,12 @@
 #include "mock_classes.hh"
 #pragma GCC diagnostic pop
 
+#include <cstdio>
 #include <sstream>
 
 #include "Achilles/EventWriter.hh"
+#include "Achilles/EventReader.hh"
+#include "Achilles/HDF5EventWriter.hh"
 #include "Achilles/Particle.hh"
 #include "Achilles/Version.hh"
 
@@ -62,3 +65,194 @@ TEST_CASE("Builtin", "[EventWriter]") {
         CHECK(ss.str() == expected);
     }
 }
+
+TEST_CASE("Zero weight policy", "[EventWriter]") {
+    static constexpr achilles::FourVector lepton{1000, 0, 0, 1000};
+    std::stringstream ss;
+    achilles::AchillesWriter writer(&ss);
+    achilles::Event event;
+    event.Leptons().emplace_back(achilles::PID::electron(), lepton, achilles::ThreeVector{},
+                                 achilles::ParticleStatus::initial_state);
+    event.Weight() = 0;
+
+    SECTION("Compact") {
+        writer.SetZeroWeightPolicy(achilles::ZeroWeightPolicy::compact);
+        writer.Write(event);
+        CHECK(ss.str() == "Event: 1\n  Weight: 0\n");
+    }
+
+    SECTION("Skip") {
+        writer.SetZeroWeightPolicy(achilles::ZeroWeightPolicy::skip);
+        writer.Write(event);
+        CHECK(ss.str().empty());
+        CHECK(writer.Offsets().empty());
+
+        // Skipped events still count towards the event number
+        event.Weight() = 1;
+        writer.Write(event);
+        CHECK(ss.str().rfind("Event: 2\n  Particles:\n", 0) == 0);
+    }
+}
+
+TEST_CASE("Asynchronous writer", "[EventWriter]") {
+    static constexpr size_t nevents = 100;
+    std::stringstream ss;
+    {
+        achilles::AsyncEventWriter writer(std::make_unique<achilles::AchillesWriter>(&ss), 4);
+        CHECK(writer.Depth() == 4);
+        for(size_t i = 0; i < nevents; ++i) {
+            achilles::Event event;
+            event.Weight() = static_cast<double>(i);
+            writer.Write(event);
+        }
+        writer.Flush();
+        CHECK(writer.Written() == nevents);
+    }
+
+    // Events are written in order
+    std::string line;
+    size_t ievent = 0;
+    while(std::getline(ss, line)) {
+        if(line.rfind("  Weight: ", 0) == 0) {
+            CHECK(line == fmt::format("  Weight: {}", static_cast<double>(ievent)));
+            ++ievent;
+        }
+    }
+    CHECK(ievent == nevents);
+}
+
+TEST_CASE("HDF5 columnar output", "[EventWriter]") {
+    static constexpr achilles::FourVector lepton0{1000, 0, 0, 1000};
+    static constexpr achilles::FourVector lepton1{313.073, 105.356, 174.207, -237.838};
+    static constexpr size_t nevents = 10;
+    const std::string filename = "test_events.h5";
+    {
+        achilles::HDF5Writer writer(filename, 4, 4);
+        writer.WriteHeader("dummy.txt");
+        for(size_t i = 0; i < nevents; ++i) {
+            achilles::Event event;
+            event.Weight() = static_cast<double>(i);
+            event.Flux() = 2;
+            // Vary the number of particles to test the offsets
+            event.Leptons().emplace_back(achilles::PID::electron(), lepton0, achilles::ThreeVector{},
+                                         achilles::ParticleStatus::initial_state);
+            if(i % 2 == 0)
+                event.Leptons().emplace_back(achilles::PID::electron(), lepton1, achilles::ThreeVector{},
+                                             achilles::ParticleStatus::final_state);
+            writer.Write(event);
+        }
+    }
+
+    achilles::HDF5Reader reader(filename);
+    CHECK(reader.Version() == ACHILLES_VERSION);
+    REQUIRE(reader.NEvents() == nevents);
+    for(size_t i = 0; i < nevents; ++i) {
+        CHECK(reader.Weights()[i] == static_cast<double>(i));
+        CHECK(reader.Fluxes()[i] == 2);
+        CHECK(reader.Remnants()[i] == achilles::NuclearRemnant().PID());
+
+        auto particles = reader.Particles(i);
+        REQUIRE(particles.size() == (i % 2 == 0 ? 2 : 1));
+        CHECK(particles[0].ID() == achilles::PID::electron());
+        CHECK(particles[0].Momentum() == lepton0);
+        CHECK(particles[0].Status() == achilles::ParticleStatus::initial_state);
+        if(i % 2 == 0) {
+            CHECK(particles[1].Momentum() == lepton1);
+            CHECK(particles[1].Status() == achilles::ParticleStatus::final_state);
+        }
+    }
+    CHECK_THROWS_AS(reader.Particles(nevents), std::out_of_range);
+    std::remove(filename.c_str());
+}
+
+#ifdef GZIP
+TEST_CASE("Parallel gzip stream", "[EventWriter]") {
+    const std::string filename = "test_parallel.gz";
+    std::string expected;
+    {
+        // Use small blocks to produce many independent gzip members
+        static constexpr size_t threads = 3, block = 64;
+        achilles::ParallelGzipStream out(filename, 6, threads, block);
+        for(size_t i = 0; i < 1000; ++i) {
+            const auto line = fmt::format("Line {}\n", i);
+            out << line;
+            expected += line;
+        }
+        out.close();
+    }
+
+    igzstream in(filename.c_str());
+    std::string result, line;
+    while(std::getline(in, line)) result += line + "\n";
+    CHECK(result == expected);
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("Parallel gzip stream rejects invalid levels", "[EventWriter]") {
+    CHECK_THROWS_AS(achilles::ParallelGzipStream("test_invalid.gz", 10), std::runtime_error);
+    std::remove("test_invalid.gz");
+}
+#endif
+
+TEST_CASE("Indexed event reader", "[EventWriter]") {
+    static constexpr size_t nevents = 50;
+    auto write = [](const std::string &filename, bool zipped) {
+        achilles::AchillesWriter writer(filename, zipped);
+        writer.WriteHeader("dummy.txt");
+        for(size_t i = 0; i < nevents; ++i) {
+            achilles::Event event;
+            event.Weight() = static_cast<double>(i);
+            writer.Write(event);
+        }
+    };
+    auto check = [](const achilles::AchillesReader &reader) {
+        REQUIRE(reader.NEvents() == nevents);
+        for(size_t i : {size_t{0}, size_t{17}, nevents - 1}) {
+            const auto event = reader.Event(i);
+            CHECK(event.rfind(fmt::format("Event: {}\n", i + 1), 0) == 0);
+            CHECK(event.find(fmt::format("Weight: {}\n", static_cast<double>(i))) != std::string::npos);
+        }
+        CHECK_THROWS_AS(reader.Event(nevents), std::out_of_range);
+
+        size_t total = 0;
+        for(size_t shard = 0; shard < 3; ++shard) {
+            auto range = reader.Shard(shard, 3);
+            total += range.second - range.first;
+        }
+        CHECK(total == nevents);
+    };
+
+    SECTION("Uncompressed") {
+        const std::string filename = "test_reader.txt";
+        write(filename, false);
+        {
+            achilles::AchillesReader reader(filename);
+            CHECK_FALSE(reader.Compressed());
+            check(reader);
+            CHECK(reader.RawEvent(3) == reader.Event(3));
+        }
+
+        // The index is rebuilt if the sidecar is missing
+        std::remove(achilles::EventIndex::Filename(filename).c_str());
+        {
+            achilles::AchillesReader reader(filename);
+            check(reader);
+        }
+        std::remove(filename.c_str());
+    }
+
+#ifdef GZIP
+    SECTION("Block compressed") {
+        const std::string filename = "test_reader.txt.gz";
+        write(filename, true);
+        {
+            achilles::AchillesReader reader(filename);
+            CHECK(reader.Compressed());
+            check(reader);
+        }
+        std::remove(achilles::EventIndex::Filename(filename).c_str());
+        CHECK_THROWS_AS(achilles::AchillesReader(filename), std::runtime_error);
+        std::remove(filename.c_str());
+    }
+#endif
+}
@@ -174,6 +174,71 @@ TEST_CASE("Coherent", "[FormFactor]") {
     }
 }
 
+TEST_CASE("Tabulated", "[FormFactor]") {
+    YAML::Node node = YAML::Load(R"node(
+        vector:
+          Form Factor: Kelly
+          Q2 Max: 10
+          Tolerance: 1.0e-7
+        coherent:
+          Form Factor: Helm
+          Q2 Min: 1
+          Q2 Max: 1.0e5
+        Kelly:
+          lambdasq: 0.7174
+          Mu Proton: 2.79278
+          Mu Neutron: -1.91315
+          Gep Params: [-0.24, 10.98, 12.82, 21.97]
+          Gen Params: [1.70, 3.30]
+          Gmp Params: [0.12, 10.97, 18.86, 6.55]
+          Gmn Params: [2.33, 14.72, 24.20, 84.1]
+        Helm:
+          s: 1
+          A: 40
+        )node");
+
+    SECTION("Matches the analytic form factor") {
+        achilles::TabulatedFormFactor ff(achilles::FFType::vector, node);
+        auto kelly = achilles::Kelly::Construct(achilles::FFType::vector, node["Kelly"]);
+        CHECK(ff.MaxDeviation() < 1e-7);
+        for(const double Q2 : {0.0, 1e-3, 0.0371, 0.5, 1.234, 7.77, 10.0, 12.0}) {
+            achilles::FormFactor::Values tabulated, exact;
+            ff.Evaluate(Q2, tabulated);
+            kelly -> Evaluate(Q2, exact);
+            CHECK(tabulated.Gep == Approx(exact.Gep).margin(1e-7));
+            CHECK(tabulated.Gmn == Approx(exact.Gmn).margin(1e-7));
+            CHECK(tabulated.F1p == Approx(exact.F1p).margin(1e-7));
+            CHECK(tabulated.F2n == Approx(exact.F2n).margin(1e-7));
+            // Only the values of the tabulated type are set
+            CHECK(tabulated.FA == 0);
+            CHECK(tabulated.Fcoh == 0);
+        }
+    }
+
+    SECTION("Coherent form factors") {
+        auto ff = achilles::FormFactorFactory::Initialize("Tabulated", achilles::FFType::coherent, node);
+        auto helm = achilles::HelmFormFactor::Construct(achilles::FFType::coherent, node["Helm"]);
+        for(const double Q2 : {1.0, 123.4, 5.0e4}) {
+            achilles::FormFactor::Values tabulated, exact;
+            ff -> Evaluate(Q2, tabulated);
+            helm -> Evaluate(Q2, exact);
+            CHECK(tabulated.Fcoh == Approx(exact.Fcoh).margin(1e-6));
+        }
+    }
+
+    SECTION("Invalid configurations throw") {
+        CHECK_THROWS_WITH(achilles::TabulatedFormFactor(achilles::FFType::axial, node),
+                          "TabulatedFormFactor: No axial form factor to tabulate");
+        // The Helm form factor is undefined at Q2 = 0
+        node["coherent"]["Q2 Min"] = 0;
+        CHECK_THROWS_WITH(achilles::TabulatedFormFactor(achilles::FFType::coherent, node),
+                          "TabulatedFormFactor: Form factor is not finite at Q2 = 0");
+        node["vector"]["Form Factor"] = "Tabulated";
+        CHECK_THROWS_WITH(achilles::TabulatedFormFactor(achilles::FFType::vector, node),
+                          "TabulatedFormFactor: Can not tabulate a tabulated form factor");
+    }
+}
+
 TEST_CASE("Builder", "[FormFactor]") {
     YAML::Node vector = YAML::Load("lambda: 1\nMu Proton: 1\nMu Neutron: 1");
     YAML::Node axial = YAML::Load("MA: 1\ngan1: 1\ngans: 1");
@@ -4,6 +4,9 @@
 #include "Achilles/HadronicMapper.hh"
 #include "Achilles/ParticleInfo.hh"
 #include "Achilles/FourVector.hh"
+#include "Achilles/SpectralFunction.hh"
+
+#include <random>
 
 TEST_CASE("HadronicMapper", "[PhaseSpace]") {
     SECTION("Forward Map") {
@@ -58,3 +61,51 @@ TEST_CASE("HadronicMapper", "[PhaseSpace]") {
         }
     }
 }
+
+TEST_CASE("QESpectral importance sampling", "[PhaseSpace]") {
+    achilles::SpectralFunction spectral("data/pke12_tot.data");
+    auto sampler = std::make_shared<const achilles::SpectralSampler>(spectral);
+    achilles::QESpectralMapper flat(0);
+    achilles::QESpectralMapper sampled(0, sampler);
+    flat.SetMasses({0, 0, 0, 0});
+    sampled.SetMasses({0, 0, 0, 0});
+    const achilles::FourVector beam{1000, 0, 0, 1000};
+
+    SECTION("Reverse map") {
+        std::vector<achilles::FourVector> mom = {{}, beam};
+        std::vector<double> ran = {0.3, 0.6, 0.2, 0.7};
+        sampled.GeneratePoint(mom, ran);
+        std::vector<double> ran2(4);
+        sampled.GenerateWeight(mom, ran2);
+        for(size_t i = 0; i < ran.size(); ++i) CHECK(ran[i] == Approx(ran2[i]));
+        CHECK(sampled.ToYAML()["Sampled"].as<bool>());
+    }
+
+    SECTION("Both mappers estimate the same integral") {
+        // Integrate p^2 S(p, E) over the allowed region, the sampled mapper should
+        // give the same result with a much smaller variance
+        std::mt19937 gen(12345);
+        std::uniform_real_distribution<double> dist(0, 1);
+        constexpr size_t ncalls = 20000;
+        auto integrate = [&](achilles::QESpectralMapper &mapper) {
+            double sum{}, sum2{};
+            for(size_t i = 0; i < ncalls; ++i) {
+                std::vector<double> ran = {dist(gen), dist(gen), dist(gen), dist(gen)};
+                std::vector<achilles::FourVector> mom = {{}, beam};
+                mapper.GeneratePoint(mom, ran);
+                std::vector<double> ran2(4);
+                const double wgt = mapper.GenerateWeight(mom, ran2);
+                const double val = spectral(mom[0].P(), achilles::Constant::mN - mom[0].E())/wgt;
+                sum += val;
+                sum2 += val*val;
+            }
+            const double mean = sum/ncalls;
+            return std::make_pair(mean, std::sqrt((sum2/ncalls - mean*mean)/ncalls));
+        };
+        const auto result_flat = integrate(flat);
+        const auto result_sampled = integrate(sampled);
+        const double sigma = std::hypot(result_flat.second, result_sampled.second);
+        CHECK(std::abs(result_flat.first - result_sampled.first) < 5*sigma);
+        CHECK(result_sampled.second < result_flat.second/5);
+    }
+}
@@ -1,6 +1,7 @@
 #include "catch2/catch.hpp"
 
 #include "mock_classes.hh"
+#include "Achilles/Constants.hh"
 #include "Achilles/HardScattering.hh"
 
 #ifdef ENABLE_BSM
@@ -46,6 +47,9 @@ TEST_CASE("CrossSection", "[HardScattering]") {
     REQUIRE_CALL(*sherpa, Calc(pids, mom, 100))
         .TIMES(1)
         .LR_RETURN((lCurrent));
+    REQUIRE_CALL(*sherpa, Bosons(trompeloeil::_))
+        .TIMES(3)
+        .RETURN(std::vector<int>{23});
     REQUIRE_CALL(*sherpa, FormFactors(achilles::PID::proton(), 23))
         .TIMES(1)
         .LR_RETURN((ffInfo[0].at(23)));
@@ -82,3 +86,101 @@ TEST_CASE("FillEvent", "[HardScattering]") {
 }
 
 #endif
+
+#ifndef ENABLE_BSM
+
+TEST_CASE("Form factors are set up with the process", "[HardScattering]") {
+    achilles::Process_Info info; 
+    info.m_ids = {achilles::PID::electron(), achilles::PID::electron()};
+    info.m_states = {{{achilles::PID::proton()}, {achilles::PID::proton()}}};
+    std::vector<achilles::FourVector> momentum = {{100, 0, 0, 100}, {100, 0, 0, -100},
+                                                  {100, 50, 0, 50}, {100, -50, 0, -50}};
+
+    const std::complex<double> coupl(0, achilles::Constant::ee);
+    std::vector<achilles::NuclearModel::FFInfoMap> ffInfo(3);
+    ffInfo[0][22] = {{achilles::FormFactorInfo::Type::F1p, coupl}, {achilles::FormFactorInfo::Type::F2p, coupl}};
+    ffInfo[1][22] = {{achilles::FormFactorInfo::Type::F1n, coupl}, {achilles::FormFactorInfo::Type::F2n, coupl}};
+    ffInfo[2][22] = {{achilles::FormFactorInfo::Type::FCoh, 6.0*coupl}};
+
+    std::vector<achilles::NuclearModel::Currents> hCurrent(1);
+    hCurrent[0][22] = {{10, 10, 10, 10}};
+    size_t nspins = 1;
+
+    MockEvent event;
+    REQUIRE_CALL(event, Momentum())
+        .TIMES(6)
+        .LR_RETURN((momentum));
+    auto model = std::make_unique<MockNuclearModel>();
+    // The same couplings are used for each event
+    REQUIRE_CALL(*model, CalcCurrents(trompeloeil::_, ffInfo))
+        .TIMES(2)
+        .LR_RETURN((hCurrent));
+    REQUIRE_CALL(*model, NSpins())
+        .TIMES(4)
+        .LR_RETURN((nspins));
+
+    achilles::HardScattering scattering;
+    scattering.SetProcess(info);
+    scattering.SetNuclear(std::move(model));
+    auto xsec1 = scattering.CrossSection(event);
+    auto xsec2 = scattering.CrossSection(event);
+    CHECK(xsec1.size() == 1);
+    CHECK(xsec1 == xsec2);
+}
+
+#endif
+
+TEST_CASE("CurrentTensor", "[HardScattering]") {
+    achilles::BosonSlots bosons;
+    CHECK(bosons.Add(22) == 0);
+    CHECK(bosons.Add(23) == 1);
+    CHECK(bosons.Add(22) == 0);
+    CHECK(bosons.Slot(24) == achilles::BosonSlots::npos);
+
+    using Complex = std::complex<double>;
+    achilles::CurrentTensor::Current lphoton = {{{1, 1}, 2, 3, 4}, {5, {6, -1}, 7, 8}};
+    achilles::CurrentTensor::Current lz = {{1, 0, 0, 1}, {0, {0, 1}, 1, 0}};
+    achilles::CurrentTensor::Current hphoton = {{2, 1, {0, 1}, 0}, {1, 1, 1, 1}, {0, 0, 3, 1}};
+    achilles::CurrentTensor lepton(2);
+    lepton.Set(0, lphoton);
+    lepton.Set(1, lz);
+
+    SECTION("Missing bosons do not contribute") {
+        achilles::CurrentTensor hadron;
+        hadron.Pack(bosons, {{22, hphoton}, {24, hphoton}}, 3);
+        CHECK(hadron.Active(0));
+        CHECK(!hadron.Active(1));
+
+        double expected = 0;
+        for(size_t i = 0; i < 2; ++i) {
+            for(size_t j = 0; j < 3; ++j) {
+                Complex amp = lphoton[i][0]*hphoton[j][0];
+                for(size_t mu = 1; mu < 4; ++mu) amp -= lphoton[i][mu]*hphoton[j][mu];
+                expected += std::norm(amp);
+            }
+        }
+        CHECK(achilles::ContractSquared(lepton, hadron) == Approx(expected));
+    }
+
+    SECTION("Bosons are summed coherently") {
+        achilles::CurrentTensor hadron;
+        hadron.Pack(bosons, {{22, hphoton}, {23, hphoton}}, 3);
+
+        double expected = 0;
+        for(size_t i = 0; i < 2; ++i) {
+            for(size_t j = 0; j < 3; ++j) {
+                Complex amp = (lphoton[i][0] + lz[i][0])*hphoton[j][0];
+                for(size_t mu = 1; mu < 4; ++mu) amp -= (lphoton[i][mu] + lz[i][mu])*hphoton[j][mu];
+                expected += std::norm(amp);
+            }
+        }
+        CHECK(achilles::ContractSquared(lepton, hadron) == Approx(expected));
+    }
+
+    SECTION("Invalid sizes throw") {
+        CHECK_THROWS_WITH(achilles::CurrentTensor(5),
+                          "CurrentTensor: Requested 5 spin states, but at most 4 are supported");
+        achilles::CurrentTensor hadron(4);
+        CHECK_THROWS_WITH(hadron.Set(0, hphoton), "CurrentTensor: Expected 4 spin states, but got 3");
+    }
+}
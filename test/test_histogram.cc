@@ -4,6 +4,7 @@
 #include "Achilles/Histogram.hh"
 
 #include <sstream>
+#include <thread>
 
 TEST_CASE("Histogram Stats", "[Histogram]") {
     achilles::Histogram hist(11, -0.5, 10.5, "test");
@@ -50,3 +51,88 @@ TEST_CASE("Histogram Stats", "[Histogram]") {
         CHECK(hist2.Integral() == 1.0);
     }
 }
+
+TEST_CASE("Histogram Binning", "[Histogram]") {
+    // Uniform bins are found directly, and must agree with the search over the edges
+    achilles::Histogram uniform(10, 0, 1, "uniform");
+    achilles::Histogram edges({0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0, 2.0}, "edges");
+    const std::vector<double> values{-1, 0, 1e-12, 0.1, 0.15, 0.2, 0.3, 0.7, 0.99, 1.0, 1.5};
+    for(const auto &x : values) {
+        uniform.Fill(x);
+        edges.Fill(x);
+    }
+
+    for(size_t i = 0; i < 10; ++i) {
+        CHECK(uniform.Integral(i, i) == Approx(edges.Integral(i, i)));
+    }
+    CHECK(uniform.Entries() == values.size());
+    CHECK(edges.Integral(10, 10) == Approx(1));
+
+    SECTION("Batched fill") {
+        achilles::Histogram batched(10, 0, 1, "batched");
+        batched.Fill(values, std::vector<double>(values.size(), 1.0));
+        CHECK(batched.Integral() == Approx(uniform.Integral()));
+        CHECK_THROWS_AS(batched.Fill(values, {1.0}), std::runtime_error);
+    }
+}
+
+TEST_CASE("Histogram Threads", "[Histogram]") {
+    static constexpr size_t nthreads = 4, nfills = 10000;
+    achilles::Histogram hist(10, 0, 10, "threads");
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < nthreads; ++i) {
+        threads.emplace_back([&hist]() {
+            for(size_t j = 0; j < nfills; ++j)
+                hist.Fill(static_cast<double>(j % 10) + 0.5);
+        });
+    }
+    for(auto &thread : threads) thread.join();
+
+    CHECK(hist.Entries() == nthreads*nfills);
+    CHECK(hist.Integral() == Approx(nthreads*nfills));
+
+    // Copies and moves keep the contributions of all threads
+    achilles::Histogram copy = hist;
+    CHECK(copy.Integral() == Approx(nthreads*nfills));
+    achilles::Histogram moved = std::move(hist);
+    moved.Fill(0.5);
+    CHECK(moved.Entries() == nthreads*nfills + 1);
+}
+
+TEST_CASE("Histogram Threads with many histograms", "[Histogram]") {
+    // Filling many histograms in turn must not create a new shard for every fill
+    static constexpr size_t nthreads = 2, nhists = 40, nfills = 100;
+    std::vector<achilles::Histogram> hists;
+    for(size_t i = 0; i < nhists; ++i) hists.emplace_back(10, 0, 10, fmt::format("hist{}", i));
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < nthreads; ++i) {
+        threads.emplace_back([&hists]() {
+            for(size_t j = 0; j < nfills; ++j)
+                for(auto &hist : hists) hist.Fill(static_cast<double>(j % 10) + 0.5);
+        });
+    }
+    for(auto &thread : threads) thread.join();
+
+    for(const auto &hist : hists) {
+        CHECK(hist.NShards() == nthreads);
+        CHECK(hist.Entries() == nthreads*nfills);
+    }
+}
+
+TEST_CASE("Histogram Threads clean up destroyed histograms", "[Histogram]") {
+    // Short lived histograms must not leave their shards behind in the filling thread
+    static constexpr size_t nhists = 1000;
+    achilles::Histogram persistent(10, 0, 10, "persistent");
+    size_t nlocal{};
+    std::thread thread([&persistent, &nlocal]() {
+        for(size_t i = 0; i < nhists; ++i) {
+            achilles::Histogram hist(10, 0, 10, fmt::format("hist{}", i));
+            hist.Fill(0.5);
+            persistent.Fill(0.5);
+        }
+        nlocal = achilles::Histogram::NLocalShards();
+    });
+    thread.join();
+    CHECK(nlocal <= 32);
+    CHECK(persistent.Entries() == nhists);
+}
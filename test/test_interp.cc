@@ -229,3 +229,44 @@ TEST_CASE("Two Dimensional", "[Interp]") {
 
     }
 }
+
+TEST_CASE("Regular Grid", "[Interp]") {
+    const std::vector<double> x = achilles::Linspace(0, 11, 23);
+    const std::vector<double> y = achilles::Linspace(0, 11, 12);
+    const std::vector<double> x_ = achilles::Linspace(0, 11, 57);
+    const std::vector<double> y_ = achilles::Linspace(0, 11, 31);
+
+    SECTION("Valid Input") {
+        const std::vector<double> irregular = {0, 1, 3, 4, 5};
+        const std::vector<double> z(irregular.size()*y.size());
+        CHECK_THROWS_WITH(achilles::RegularGridInterp2D(irregular, y, z), "Inputs must be equally spaced.");
+        CHECK_THROWS_WITH(achilles::RegularGridInterp2D(x, y, z), "Input and output arrays must be the same size.");
+        CHECK(achilles::RegularGridInterp2D::IsRegular(x));
+        CHECK_FALSE(achilles::RegularGridInterp2D::IsRegular(irregular));
+    }
+
+    SECTION("Matches polynomial interpolation") {
+        std::vector<double> z;
+        for(const auto &xi : x) 
+            for(const auto &yi : y)
+                z.emplace_back(std::sin(xi)*std::exp(-yi/3) + xi*yi);
+        achilles::Interp2D interp(x, y, z, achilles::InterpolationType::Polynomial);
+        interp.SetPolyOrder(3, 1);
+        achilles::RegularGridInterp2D grid(x, y, z);
+
+        for(const auto &xi : x_) {
+            for(const auto &yi : y_) {
+                CHECK(grid(xi, yi) == Approx(interp(xi, yi)).margin(1e-12)); 
+            }
+        }
+    }
+
+    SECTION("No extrapolation allowed") {
+        const std::vector<double> z(x.size()*y.size());
+        achilles::RegularGridInterp2D grid(x, y, z);
+        CHECK_THROWS_WITH(grid(-1, 0),
+                          fmt::format("Input ({}) less than minimum x value ({})", -1, 0));
+        CHECK_THROWS_WITH(grid(0, 12),
+                          fmt::format("Input ({}) greater than maximum y value ({})", 12, 11));
+    }
+}
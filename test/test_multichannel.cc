@@ -117,6 +117,21 @@ TEST_CASE("Multi-Channel Integration", "[multichannel]") {
         CHECK(std::abs(results.sum_results.Mean() - 1.0) < nsigma*results.sum_results.Error());
         CHECK(results.sum_results.Error()/results.sum_results.Mean() < rtol);
     }
+
+    SECTION("Strata are sized from the calls of each channel") {
+        static constexpr size_t nitn_min = 2;
+        static constexpr double rtol = 1;
+        achilles::MultiChannel integrator(1, integrand.NChannels(),
+                                          achilles::MultiChannelParams{1000, nitn_min, rtol});
+        integrator.Optimize(integrand);
+
+        // Each channel receives only part of the calls, with at least 4 calls per hypercube
+        const auto ncalls = integrator.Parameters().ncalls;
+        for(const auto &channel : integrand.Channels()) {
+            CHECK(channel.integrator.Strata().NHypercubes() > 1);
+            CHECK(4*channel.integrator.Strata().NHypercubes() <= ncalls);
+        }
+    }
 }
 
 TEST_CASE("YAML encoding / decoding Multichannel", "[multichannel]") {
@@ -156,3 +171,50 @@ TEST_CASE("YAML encoding / decoding Multichannel", "[multichannel]") {
     CHECK(results1.sum_results.Error() == results2.sum_results.Error());
     CHECK(results1.best_weights == results2.best_weights);
 }
+
+TEST_CASE("Binary checkpoint of Multichannel", "[multichannel]") {
+    auto build_integrand = []() {
+        achilles::Integrand<double> integrand(test_func_exp);
+        for(size_t i = 0; i < 2; ++i) {
+            achilles::Channel<double> channel;
+            achilles::AdaptiveMap map(1, 50);
+            channel.integrator = achilles::Vegas(map, achilles::VegasParams{});
+            channel.mapping = std::make_unique<DoubleMapper>(i);
+            integrand.AddChannel(std::move(channel));
+        }
+        return integrand;
+    };
+    auto integrand = build_integrand();
+    static constexpr size_t ncalls = 1000, nitn_min = 2;
+    static constexpr double rtol = 1;
+    achilles::MultiChannel integrator(1, integrand.NChannels(),
+                                      achilles::MultiChannelParams{ncalls, nitn_min, rtol});
+    integrator.Optimize(integrand);
+    auto results1 = integrator.Summary();
+
+    std::stringstream data;
+    integrator.SaveState(data);
+    integrand.SaveState(data);
+
+    auto integrand2 = build_integrand();
+    achilles::MultiChannel integrator2(1, integrand2.NChannels(), achilles::MultiChannelParams{});
+    REQUIRE(integrator2.LoadState(data));
+    REQUIRE(integrand2.LoadState(data));
+    auto results2 = integrator2.Summary();
+
+    CHECK(integrator2.Parameters().ncalls == integrator.Parameters().ncalls);
+    CHECK(integrator2.Parameters().iteration == integrator.Parameters().iteration);
+    CHECK(results1.sum_results == results2.sum_results);
+    CHECK(results1.best_weights == results2.best_weights);
+    for(size_t i = 0; i < integrand.NChannels(); ++i) {
+        CHECK(integrand.GetChannel(i).integrator.Grid().Hist()
+              == integrand2.GetChannel(i).integrator.Grid().Hist());
+    }
+
+    SECTION("Mismatched layouts are rejected") {
+        std::stringstream data2;
+        integrator.SaveState(data2);
+        achilles::MultiChannel integrator3(1, 3, achilles::MultiChannelParams{});
+        CHECK_FALSE(integrator3.LoadState(data2));
+    }
+}
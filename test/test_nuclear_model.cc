@@ -106,11 +106,8 @@ Nucleus:
             .LR_RETURN(std::move(form_factor));
         achilles::Coherent model(config, ff, builder);
 
-        std::vector<achilles::Particle> nucleons{};
         auto nucleus = std::make_shared<MockNucleus>();
-        REQUIRE_CALL(*nucleus, Nucleons())
-            .TIMES(3)
-            .LR_RETURN((nucleons));
+        FORBID_CALL(*nucleus, Nucleons());
 
         std::vector<achilles::FourVector> momentum = {{11.178_GeV, 0, 0, 0},
                                                       {4.159051495317648_GeV, 0, 0, 4.159051495317648_GeV},
@@ -287,13 +284,16 @@ NuclearModel:
             .LR_RETURN(std::move(form_factor));
         achilles::QESpectral model(config, ff, builder);
 
-        std::vector<achilles::Particle> nucleons{achilles::PID::proton(), achilles::PID::neutron()};
+        // The weights only depend on the number of protons and neutrons,
+        // the nucleon configuration should not be needed
         auto nucleus = std::make_shared<MockNucleus>();
-        REQUIRE_CALL(*nucleus, Nucleons())
-            .TIMES(5) // Should be 2*nucleons.size()+1
-            .LR_RETURN((nucleons));
+        ALLOW_CALL(*nucleus, NProtons())
+            .LR_RETURN((1UL));
+        ALLOW_CALL(*nucleus, NNeutrons())
+            .LR_RETURN((1UL));
+        FORBID_CALL(*nucleus, Nucleons());
         achilles::Event event(1);
-        event.MatrixElementWgts().resize(nucleons.size());
+        event.MatrixElementWgts().resize(2);
         event.CurrentNucleus() = nucleus;
 
         std::vector<double> xsecs = {10, 20};
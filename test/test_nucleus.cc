@@ -125,6 +125,23 @@ TEST_CASE("Nuclear Configuration", "[Nucleus]") {
         CHECK(nuc.Nucleons()[i].Momentum().P() < kf);
         CHECK(nuc.Nucleons()[i].Position() == achilles::ThreeVector());
     }
+
+    SECTION("Locations follow the nucleons") {
+        // Add an extra proton, as is done when the cascade is run on a single particle
+        auto nucleons = nuc.Nucleons();
+        nucleons.emplace_back(achilles::PID::proton());
+        for(size_t i = 0; i < 3; ++i) nuc.SetNucleons(nucleons);
+
+        CHECK(nuc.ProtonsIDs().size() == Z+1);
+        CHECK(nuc.NeutronsIDs().size() == Z);
+        CHECK(nuc.ProtonsIDs().back() == 2*Z);
+        for(const auto &idx : nuc.ProtonsIDs()) CHECK(nuc.Nucleons()[idx].ID() == achilles::PID::proton());
+        for(const auto &idx : nuc.NeutronsIDs()) CHECK(nuc.Nucleons()[idx].ID() == achilles::PID::neutron());
+
+        // The species content of the nucleus is not changed
+        CHECK(nuc.NProtons() == Z);
+        CHECK(nuc.NNeutrons() == Z);
+    }
 }
 
 TEST_CASE("Make Nucleus", "[Nucleus]") {
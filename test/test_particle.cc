@@ -4,6 +4,7 @@
 
 #include "Achilles/Constants.hh"
 #include "Achilles/Particle.hh"
+#include "Achilles/ParticleView.hh"
 #include "Approx.hh"
 
 constexpr double energy = 1000;
@@ -84,3 +85,31 @@ TEST_CASE("I/O", "[Particle]") {
 
     CHECK(part == part2);
 }
+
+TEST_CASE("Particle view", "[Particle]") {
+    const std::vector<achilles::Particle> hadrons{
+        {achilles::PID::proton(), {energy, 100, 0, 0}},
+        {achilles::PID::neutron(), {energy, 0, 100, 0}}};
+    const std::vector<achilles::Particle> leptons{
+        {achilles::PID::electron(), {energy, 0, 0, 100}}};
+    const std::vector<achilles::Particle> empty{};
+
+    SECTION("Concatenates both ranges without copying") {
+        achilles::ParticleView view(hadrons, leptons);
+        CHECK(view.size() == 3);
+        CHECK(&view[0] == &hadrons[0]);
+        CHECK(&view[2] == &leptons[0]);
+        CHECK(view.Copy() == std::vector<achilles::Particle>{hadrons[0], hadrons[1], leptons[0]});
+
+        size_t idx = 0;
+        for(const auto &part : view) CHECK(&part == &view[idx++]);
+        CHECK(idx == view.size());
+    }
+
+    SECTION("Empty ranges are skipped") {
+        CHECK(achilles::ParticleView(empty, leptons).Copy() == leptons);
+        CHECK(achilles::ParticleView(hadrons, empty).Copy() == hadrons);
+        CHECK(achilles::ParticleView(empty, empty).empty());
+        CHECK(achilles::ParticleView(empty, empty).begin() == achilles::ParticleView(empty, empty).end());
+    }
+}
@@ -1,4 +1,10 @@
 #include "catch2/catch.hpp"
+
+#include "Achilles/Interpolation.hh"
+#include "Achilles/SpectralFunction.hh"
+#include "Achilles/Utilities.hh"
+
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
@@ -49,3 +55,100 @@ TEST_CASE("Overestimate of Spectral Function", "[spectral]") {
     }
     result.close();
 }
+
+TEST_CASE("Spectral function on a regular grid", "[spectral]") {
+    const std::string filename = "data/pke12_tot.data"; 
+    achilles::SpectralFunction spectral(filename);
+    const auto &mom = spectral.Momentum();
+    const auto &energy = spectral.Energy();
+
+    std::ifstream data(filename);
+    size_t nep{}, np{};
+    data >> nep >> np;
+    std::vector<double> pke(nep*np);
+    double tmp{};
+    for(size_t i = 0; i < np; ++i) {
+        data >> tmp;
+        for(size_t j = 0; j < nep; ++j) {
+            data >> tmp >> pke[i*nep+j];
+        }
+    }
+    data.close();
+
+    achilles::Interp2D interp(mom, energy, pke, achilles::InterpolationType::Polynomial);
+    interp.SetPolyOrder(3, 1);
+
+    auto p = achilles::Linspace(spectral.MinMomentum(), spectral.MaxMomentum(), 301);
+    auto E = achilles::Linspace(spectral.MinEnergy(), spectral.MaxEnergy(), 199);
+    // Avoid round off pushing the last point outside of the table
+    p.back() = spectral.MaxMomentum();
+    E.back() = spectral.MaxEnergy();
+    for(const auto &pi : p) {
+        for(const auto &ei : E) {
+            const double expected = std::max(interp(pi, ei), 0.0);
+            CHECK(spectral(pi, ei) == Approx(expected).margin(1e-16)); 
+        }
+    }
+    CHECK(spectral(spectral.MaxMomentum()+1, spectral.MinEnergy()) == 0);
+
+#if defined(CATCH_CONFIG_ENABLE_BENCHMARKING)
+    BENCHMARK("Polynomial interpolation") {
+        double sum = 0;
+        for(const auto &ei : E) sum += interp(400, ei);
+        return sum;
+    };
+
+    BENCHMARK("Regular grid") {
+        double sum = 0;
+        for(const auto &ei : E) sum += spectral(400, ei);
+        return sum;
+    };
+#endif
+}
+
+TEST_CASE("Spectral function sampler", "[spectral]") {
+    achilles::SpectralFunction spectral("data/pke12_tot.data");
+    achilles::SpectralSampler sampler(spectral);
+
+    SECTION("CDFs are inverted by the sampling") {
+        for(const auto &ran : achilles::Linspace(0.01, 0.99, 25)) {
+            const double p = sampler.SampleMomentum(ran);
+            CHECK(sampler.MomentumCDF(p) == Approx(ran));
+            const double E = sampler.SampleEnergy(p, ran);
+            CHECK(sampler.EnergyCDF(p, E) == Approx(ran));
+        }
+    }
+
+    SECTION("Densities are normalized") {
+        // The densities are constant within each cell, so the number of steps is chosen
+        // as a multiple of the number of cells in the table
+        size_t n = 50*(spectral.Momentum().size() - 1);
+        const double hp = (sampler.MaxMomentum() - sampler.MinMomentum())/static_cast<double>(n);
+        double norm_p{};
+        for(size_t i = 0; i < n; ++i) {
+            norm_p += sampler.MomentumDensity(sampler.MinMomentum() + (static_cast<double>(i) + 0.5)*hp)*hp;
+        }
+        CHECK(norm_p == Approx(1));
+
+        n = 50*(spectral.Energy().size() - 1);
+        const double he = (sampler.MaxEnergy() - sampler.MinEnergy())/static_cast<double>(n);
+        double norm_e{};
+        for(size_t i = 0; i < n; ++i) {
+            norm_e += sampler.EnergyDensity(220, sampler.MinEnergy() + (static_cast<double>(i) + 0.5)*he)*he;
+        }
+        CHECK(norm_e == Approx(1));
+    }
+
+    SECTION("Density follows the spectral function") {
+        // The peak of p^2 S(p, E) should be sampled more often than the tail
+        CHECK(sampler.Density(220, 20) > 100*sampler.Density(700, 300));
+        CHECK(sampler.Density(220, 20) > 0);
+        CHECK(sampler.Density(700, 300) > 0);
+    }
+
+    SECTION("Invalid input") {
+        std::vector<const achilles::SpectralFunction*> funcs;
+        CHECK_THROWS_WITH(achilles::SpectralSampler(funcs),
+                          "SpectralSampler: Requires at least one spectral function");
+    }
+}
@@ -1,6 +1,7 @@
 #include "catch2/catch.hpp"
 
 #include "Achilles/Spinor.hh"
+#include "Achilles/DiracAlgebra.hh"
 #include "Achilles/Constants.hh"
 #include <sstream>
 #include <iostream>
@@ -90,3 +91,114 @@ TEST_CASE("GammaMatrix", "[Spinors]") {
         }
     }
 }
+
+TEST_CASE("DiracAlgebra", "[Spinors]") {
+    const achilles::FourVector pOut{1200, 300, -150, 650};
+    const achilles::FourVector pIn{-900, 100, 200, -30};
+    const achilles::FourVector qVec{300, 400, 50, 620};
+    const auto ubar = achilles::UBarSpinors(pOut);
+    const auto u = achilles::USpinors(pIn);
+
+    SECTION("Sandwich matches spinor products") {
+        const auto &dirac = achilles::DiracMatrices::Instance();
+        const std::complex<double> cl(0, 0.3), cr(0, -0.1);
+        achilles::DiracMatrices::Vertex vertex;
+        for(size_t mu = 0; mu < 4; ++mu)
+            vertex[mu] = cl*SpinMatrix::GammaMu(mu)*SpinMatrix::PL() + cr*SpinMatrix::GammaMu(mu)*SpinMatrix::PR();
+
+        const auto current = achilles::Sandwich(ubar, vertex, u);
+        for(size_t i = 0; i < 2; ++i) {
+            for(size_t j = 0; j < 2; ++j) {
+                for(size_t mu = 0; mu < 4; ++mu) {
+                    const auto expected = ubar[i]*(cl*dirac.gamma[mu]*dirac.pl + cr*dirac.gamma[mu]*dirac.pr)*u[j];
+                    CHECK(current[2*i+j][mu].real() == Approx(expected.real()).margin(1e-8));
+                    CHECK(current[2*i+j][mu].imag() == Approx(expected.imag()).margin(1e-8));
+                }
+            }
+        }
+    }
+
+    SECTION("Nucleon bilinears match the full vertex") {
+        const std::complex<double> f1(0.8, 0.1), f2(3.1, 0), fa(-1.2, 0.3);
+        static constexpr double mass = 938;
+        const achilles::NucleonBilinears bilinears(ubar, u, qVec);
+        const auto current = bilinears(f1, f2, fa, mass);
+        for(size_t mu = 0; mu < 4; ++mu) {
+            auto vertex = f1*SpinMatrix::GammaMu(mu) + fa*SpinMatrix::GammaMu(mu)*SpinMatrix::Gamma_5();
+            for(size_t nu = 0; nu < 4; ++nu) {
+                const double sign = nu == 0 ? 1 : -1;
+                vertex += std::complex<double>(0, 1)*(f2*SpinMatrix::SigmaMuNu(mu, nu)*sign*qVec[nu]/(2*mass));
+            }
+            for(size_t i = 0; i < 2; ++i) {
+                for(size_t j = 0; j < 2; ++j) {
+                    const auto expected = ubar[i]*vertex*u[j];
+                    CHECK(current[2*i+j][mu].real() == Approx(expected.real()).margin(1e-8));
+                    CHECK(current[2*i+j][mu].imag() == Approx(expected.imag()).margin(1e-8));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("SIMD spinor kernels", "[Spinors]") {
+    const achilles::FourVector pOut{1200, 300, -150, 650};
+    const achilles::FourVector pIn{-900, 100, 200, -30};
+    const auto ubar = UBarSpinor(1, pOut);
+    const auto u = USpinor(-1, pIn);
+    const SpinMatrix mat = std::complex<double>(0.3, 1.2)*SpinMatrix::GammaMu(2)*SpinMatrix::PL()
+                         + 2.0*SpinMatrix::SigmaMuNu(0, 3) + SpinMatrix::Slashed(pOut)/100.0;
+    const achilles::SplitSpinMatrix smat(mat);
+    const achilles::SplitSpinor subar(ubar), su(u);
+    const auto expected_mu = mat*u;
+    const auto expected = ubar*mat*u;
+
+    const auto original = achilles::ActiveSimd();
+    auto level = GENERATE(achilles::SimdLevel::scalar, achilles::SimdLevel::sse2, achilles::SimdLevel::avx2);
+    achilles::UseSimd(level);
+
+    const auto result_mu = achilles::Multiply(smat, su);
+    for(size_t i = 0; i < 4; ++i) {
+        CHECK(result_mu[i].real() == Approx(expected_mu[i].real()).margin(1e-10));
+        CHECK(result_mu[i].imag() == Approx(expected_mu[i].imag()).margin(1e-10));
+    }
+    const auto result = achilles::Bilinear(subar, smat, su);
+    CHECK(result.real() == Approx(expected.real()).margin(1e-8));
+    CHECK(result.imag() == Approx(expected.imag()).margin(1e-8));
+
+#if defined(CATCH_CONFIG_ENABLE_BENCHMARKING)
+    BENCHMARK("Matrix-spinor product") {
+        return achilles::Multiply(smat, su);
+    };
+
+    BENCHMARK("Bilinear") {
+        return achilles::Bilinear(subar, smat, su);
+    };
+#endif
+
+    achilles::UseSimd(original);
+}
+
+#if defined(CATCH_CONFIG_ENABLE_BENCHMARKING)
+TEST_CASE("Spinor products", "[Spinors]") {
+    const achilles::FourVector pOut{1200, 300, -150, 650};
+    const achilles::FourVector pIn{-900, 100, 200, -30};
+    const auto ubar = UBarSpinor(1, pOut);
+    const auto u = USpinor(-1, pIn);
+    const SpinMatrix mat = SpinMatrix::GammaMu(2)*SpinMatrix::PL();
+    const auto ubars = achilles::UBarSpinors(pOut);
+    const auto us = achilles::USpinors(pIn);
+    const auto &vertex = achilles::DiracMatrices::Instance().split_gamma;
+
+    BENCHMARK("SpinMatrix matrix-spinor product") {
+        return mat*u;
+    };
+
+    BENCHMARK("SpinMatrix bilinear") {
+        return ubar*mat*u;
+    };
+
+    BENCHMARK("Sandwich all helicities") {
+        return achilles::Sandwich(ubars, vertex, us);
+    };
+}
+#endif
@@ -4,6 +4,8 @@
 
 #include "catch_utils.hh"
 
+#include <sstream>
+
 TEST_CASE("Statistics class", "[vegas]") {
     SECTION("Adding individual points together") {
         achilles::StatsData data;
@@ -72,3 +74,54 @@ TEST_CASE("YAML encoding / decoding StatsData", "[vegas]") {
     CHECK(data1.Error() == data2.Error());
     CHECK(data1.FiniteCalls() == data2.FiniteCalls());
 }
+
+TEST_CASE("Streaming percentile", "[vegas]") {
+    static constexpr size_t npoints = 100000;
+    static constexpr double percentile = 0.99;
+    std::vector<double> vals(npoints);
+    for(size_t i = 0; i < npoints; ++i)
+        vals[i] = static_cast<double>((i * 7919) % npoints) / static_cast<double>(npoints);
+
+    SECTION("Estimate is accurate with bounded memory") {
+        achilles::Percentile digest(percentile);
+        for(const auto &val : vals) digest.Add(val);
+
+        CHECK(digest.Count() == static_cast<double>(npoints));
+        CHECK(digest.Size() < 2*static_cast<size_t>(achilles::Percentile::compression_default));
+        CHECK(digest.Get() == Approx(percentile).epsilon(1e-3));
+        CHECK(digest.Quantile(0.5) == Approx(0.5).epsilon(1e-2));
+        CHECK(digest.Quantile(0) == 0);
+        CHECK(digest.Quantile(1) == Approx(1 - 1.0/npoints));
+    }
+
+    SECTION("Merged digests agree with a single digest") {
+        achilles::Percentile digest1(percentile), digest2(percentile);
+        for(size_t i = 0; i < npoints; ++i) {
+            if(i % 2) digest1.Add(vals[i]);
+            else digest2.Add(vals[i]);
+        }
+        digest1.Merge(digest2);
+
+        CHECK(digest1.Count() == static_cast<double>(npoints));
+        CHECK(digest1.Get() == Approx(percentile).epsilon(1e-3));
+    }
+
+    SECTION("Digest is restored from a checkpoint") {
+        achilles::Percentile digest(percentile), restored(percentile);
+        for(const auto &val : vals) digest.Add(val);
+
+        std::stringstream state;
+        digest.SaveState(state);
+        REQUIRE(restored.LoadState(state));
+        CHECK(restored.Count() == digest.Count());
+        CHECK(restored.Get() == digest.Get());
+        CHECK(restored.Quantile(0.5) == digest.Quantile(0.5));
+
+        std::stringstream truncated(state.str().substr(0, 16));
+        CHECK_FALSE(restored.LoadState(truncated));
+    }
+
+    SECTION("Invalid percentile throws") {
+        CHECK_THROWS_AS(achilles::Percentile(1.5), std::runtime_error);
+    }
+}
@@ -0,0 +1,111 @@
+#include "catch2/catch.hpp"
+
+#include "Achilles/SpectralFunction.hh"
+#include "Achilles/TableCache.hh"
+
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+void WriteSource(const std::string &filename, const std::vector<double> &values) {
+    std::ofstream out(filename);
+    out << values.size() << "\n";
+    for(const auto &value : values) out << value << "\n";
+}
+
+achilles::Table ParseSource(const std::string &filename, size_t &ncalls) {
+    ++ncalls;
+    std::ifstream in(filename);
+    size_t size{};
+    in >> size;
+    achilles::Table table;
+    table.header = {static_cast<int64_t>(size)};
+    table.columns.resize(1);
+    table.columns[0].resize(size);
+    for(auto &value : table.columns[0]) in >> value;
+    return table;
+}
+
+}
+
+TEST_CASE("TableCache", "[TableCache]") {
+    const std::string filename = "table_cache_test.dat";
+    size_t ncalls = 0;
+    auto parser = [&](const std::string &name) { return ParseSource(name, ncalls); };
+    WriteSource(filename, {1, 2.5, 3});
+    const auto cache = achilles::TableCache::CachePath(filename, "Test");
+    std::remove(cache.c_str());
+
+    SECTION("Cache is reused") {
+        auto table = achilles::TableCache::Load(filename, "Test", parser);
+        CHECK(ncalls == 1);
+        auto cached = achilles::TableCache::Load(filename, "Test", parser);
+        CHECK(ncalls == 1);
+        CHECK(cached.header == table.header);
+        CHECK(cached.columns == table.columns);
+        CHECK(cached.columns[0] == std::vector<double>{1, 2.5, 3});
+    }
+
+    SECTION("Cache is rebuilt when the source changes") {
+        achilles::TableCache::Load(filename, "Test", parser);
+        WriteSource(filename, {4, 5});
+        auto table = achilles::TableCache::Load(filename, "Test", parser);
+        CHECK(ncalls == 2);
+        CHECK(table.columns[0] == std::vector<double>{4, 5});
+    }
+
+    SECTION("Kinds are cached separately") {
+        achilles::TableCache::Load(filename, "Test", parser);
+        achilles::TableCache::Load(filename, "Other", parser);
+        CHECK(ncalls == 2);
+        std::remove(achilles::TableCache::CachePath(filename, "Other").c_str());
+    }
+
+    SECTION("Corrupted caches are rebuilt") {
+        achilles::TableCache::Load(filename, "Test", parser);
+        {
+            std::fstream file(cache, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(-12, std::ios::end);
+            const double garbage = 42;
+            file.write(reinterpret_cast<const char*>(&garbage), sizeof(double));
+        }
+        auto table = achilles::TableCache::Load(filename, "Test", parser);
+        CHECK(ncalls == 2);
+        CHECK(table.columns[0] == std::vector<double>{1, 2.5, 3});
+    }
+
+    SECTION("Cache can be disabled") {
+        achilles::TableCache::Enable(false);
+        achilles::TableCache::Load(filename, "Test", parser);
+        achilles::TableCache::Load(filename, "Test", parser);
+        achilles::TableCache::Enable(true);
+        CHECK(ncalls == 2);
+    }
+
+    SECTION("Cache directory") {
+        achilles::TableCache::SetDirectory(".");
+        const auto path = achilles::TableCache::CachePath("data/" + filename, "Test");
+        achilles::TableCache::SetDirectory("");
+        CHECK(path.rfind("./table_cache_test.dat.", 0) == 0);
+        CHECK(path != achilles::TableCache::CachePath(filename, "Test"));
+    }
+
+    std::remove(cache.c_str());
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("Spectral function from cache", "[TableCache]") {
+    const std::string filename = "data/pke12_tot.data";
+    achilles::TableCache::SetDirectory(".");
+    achilles::SpectralFunction parsed(filename);
+    achilles::SpectralFunction cached(filename);
+    const auto cache = achilles::TableCache::CachePath(filename, "SpectralFunction");
+    achilles::TableCache::SetDirectory("");
+    std::remove(cache.c_str());
+
+    CHECK(parsed.Momentum() == cached.Momentum());
+    CHECK(parsed.Energy() == cached.Energy());
+    CHECK(parsed.Normalization() == cached.Normalization());
+    CHECK(parsed(220, 20) == cached(220, 20));
+}
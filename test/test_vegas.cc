@@ -69,6 +69,61 @@ TEST_CASE("Vegas Integration", "[vegas]") {
     }
 }
 
+TEST_CASE("Stratified sampling reduces the variance", "[vegas]") {
+    static constexpr size_t ncalls = 10000;
+    static constexpr double rtol = 1, atol = 1;
+    achilles::VegasParams params{ncalls, 2, rtol, atol, 1.5, 1};
+    achilles::Vegas stratified(achilles::AdaptiveMap(2, 100), params);
+    params.max_hypercubes = 1;
+    achilles::Vegas plain(achilles::AdaptiveMap(2, 100), params);
+    CHECK(stratified.Strata().NHypercubes() > 1);
+    CHECK(plain.Strata().NHypercubes() == 1);
+
+    // Train both integrators with the same number of calls and compare the final iteration
+    for(size_t i = 0; i < 3; ++i) {
+        stratified(test_func2);
+        plain(test_func2);
+    }
+    auto result_strat = stratified.Summary().results.back();
+    auto result_plain = plain.Summary().results.back();
+
+    CHECK(std::abs(result_strat.Mean() - 1.0) < nsigma*result_strat.Error());
+    CHECK(std::abs(result_plain.Mean() - 1.0) < nsigma*result_plain.Error());
+    CHECK(result_strat.Calls() >= ncalls);
+    CHECK(result_strat.Error()*std::sqrt(result_strat.Calls())
+          < result_plain.Error()*std::sqrt(result_plain.Calls()));
+}
+
+TEST_CASE("Refining keeps the stratified allocation", "[vegas]") {
+    static constexpr size_t ncalls = 10000;
+    static constexpr double rtol = 1, atol = 1;
+    achilles::Vegas vegas(achilles::AdaptiveMap(2, 100), achilles::VegasParams{ncalls, 2, rtol, atol, 1.5, 1});
+    for(size_t i = 0; i < 3; ++i) vegas(test_func2);
+
+    // Densities at the centers of the old hypercubes
+    const auto &strata = vegas.Strata();
+    const size_t nstrat = strata.NStrata();
+    std::vector<std::vector<double>> points;
+    std::vector<double> densities;
+    for(size_t i = 0; i < nstrat; ++i) {
+        for(size_t j = 0; j < nstrat; ++j) {
+            points.push_back({(static_cast<double>(i) + 0.5)/static_cast<double>(nstrat),
+                              (static_cast<double>(j) + 0.5)/static_cast<double>(nstrat)});
+            densities.push_back(strata.Density(strata.FindHypercube(points.back())));
+        }
+    }
+    CHECK(*std::max_element(densities.begin(), densities.end()) > 2);
+
+    vegas.Refine();
+    CHECK(vegas.Strata().NStrata() > nstrat);
+    double max_diff = 0;
+    for(size_t i = 0; i < points.size(); ++i) {
+        const double density = vegas.Strata().Density(vegas.Strata().FindHypercube(points[i]));
+        max_diff = std::max(max_diff, std::abs(density - densities[i])/densities[i]);
+    }
+    CHECK(max_diff < 0.1);
+}
+
 TEST_CASE("YAML encoding / decoding Vegas", "[vegas]") {
     static constexpr size_t nitn_min = 2;
     static constexpr double rtol = 1, atol = 1;